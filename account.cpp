@@ -1,6 +1,75 @@
 #include "account.h"
+#include <cstring>
+#include <stdexcept>
 
-bool Account::verify(const String& username, const String& password){
-  return (name_hash&(sha256(username+salt).hexdigest())) && (pass_hash&(sha256(password+salt).hexdigest())); 
+Account Account::create(const String& username, const String& salt, const String& password, salting scheme){
+  if(scheme == salt_prefix){
+    sha256_prefix salted(salt);
+    return Account(salted.hash(username), salt, salted.hash(password), scheme);
+  }
+  sha256 name_ctx;
+  name_ctx.update(username);
+  name_ctx.update(salt);
+  sha256 pass_ctx;
+  pass_ctx.update(password);
+  pass_ctx.update(salt);
+  return Account(name_ctx.finalize(), salt, pass_ctx.finalize(), scheme);
+}
+Account Account::parse(const String& record){
+  const char* p = record.c_string();
+  size_t len = record.getLength();
+  salting scheme = salt_suffix;
+  if(len >= 2 && p[1] == '$'){
+    if(p[0] == '1') scheme = salt_suffix;
+    else if(p[0] == '2') scheme = salt_prefix;
+    else throw std::invalid_argument("Ismeretlen fiók rekord verzió!");
+    p += 2;
+    len -= 2;
+  }
+  /**
+   * Két 64 karakteres hash, mindkettő után egy '$', a maradék a só.
+   */
+  if(len < 2*(2*Digest::size + 1) || p[2*Digest::size] != '$' || p[4*Digest::size + 1] != '$'){
+    throw std::invalid_argument("Hibás fiók rekord!");
+  }
+  char hex[2*Digest::size + 1];
+  memcpy(hex, p, 2*Digest::size);
+  hex[2*Digest::size] = '\0';
+  Digest name = Digest::fromHex(hex);
+  memcpy(hex, p + 2*Digest::size + 1, 2*Digest::size);
+  Digest pass = Digest::fromHex(hex);
+  return Account(name, String(p + 4*Digest::size + 2, len - 4*Digest::size - 2), pass, scheme);
+}
+String Account::serialize() const{
+  String res(scheme == salt_prefix ? "2$" : "1$");
+  res += name_hash.hex();
+  res += "$";
+  res += pass_hash.hex();
+  res += "$";
+  res += salt;
+  return res;
+}
+sha256_prefix Account::prefix() const{
+  if(scheme != salt_prefix) throw std::logic_error("Csak só elöl sémájú fiókhoz van só midstate!");
+  return sha256_prefix(salt);
+}
+bool Account::verify(const String& username, const String& password) const{
+  if(scheme == salt_prefix){
+    return verify(sha256_prefix(salt), username, password);
+  }
+  sha256 name_ctx;
+  name_ctx.update(username);
+  name_ctx.update(salt);
+  sha256 pass_ctx;
+  pass_ctx.update(password);
+  pass_ctx.update(salt);
+  bool name_ok = name_hash == name_ctx.finalize();
+  bool pass_ok = pass_hash == pass_ctx.finalize();
+  return name_ok & pass_ok;
+}
+bool Account::verify(const sha256_prefix& salted, const String& username, const String& password) const{
+  if(scheme != salt_prefix) throw std::logic_error("Csak só elöl sémájú fiók ellenőrizhető só midstate-ből!");
+  bool name_ok = name_hash == salted.hash(username);
+  bool pass_ok = pass_hash == salted.hash(password);
+  return name_ok & pass_ok;
 }
-
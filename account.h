@@ -1,25 +1,101 @@
 #include "string.h"
 #include "sha256.h"
+#include "digest.h"
 /**
  * @file account.h
  * Az Account osztály header fájlja.
  */
+/**
+ * A sózás módja, egyben a tárolt fiók rekord verziója.
+ */
+enum salting{
+  salt_suffix = 1, /**< 1. verzió (régi): H(adat || só).*/
+  salt_prefix = 2  /**< 2. verzió: H(só || adat), a só midstate-je előre kiszámolható és újrahasználható.*/
+};
 /**
  * A fiók adataihoz tartozó műveletekért felelős osztály.
  */
 class Account{
-  String name_hash,salt, pass_hash; /**< a fiók felhasználónevének + só, jelszavának + só hash értéke.*/
+  Digest name_hash; /**< a fiók felhasználónevének és sójának hash értéke.*/
+  String salt; /**< a fiókhoz tartozó só.*/
+  Digest pass_hash; /**< a fiók jelszavának és sójának hash értéke.*/
+  salting scheme; /**< a sózás módja (rekord verzió).*/
  public:
+  /**
+   * Paraméter nélküli konstruktor.
+   * Üres sóval és csupa 0 hash értékekkel inicializál.
+   */
+  Account(): name_hash(), salt(), pass_hash(), scheme(salt_suffix){};
   /**
    * Konstruktor.
+   * A hash értékeket hexadecimális alakban kapja, és binárisan tárolja.
+   * Hibás hexadecimális hash esetén exceptiont dob.
+   * @param username a felhasználónév és a só hash-e hexadecimálisan.
+   * @param salt a só.
+   * @param password a jelszó és a só hash-e hexadecimálisan.
+   * @param scheme a sózás módja, alapból a régi, só a végén.
+   */
+  Account(const String& username, const String& salt, const String& password, salting scheme = salt_suffix): name_hash(Digest::fromHex(username)), salt(salt), pass_hash(Digest::fromHex(password)), scheme(scheme){};
+  /**
+   * Konstruktor.
+   * @param username a felhasználónév és a só hash-e.
+   * @param salt a só.
+   * @param password a jelszó és a só hash-e.
+   * @param scheme a sózás módja, alapból a régi, só a végén.
+   */
+  Account(const Digest& username, const String& salt, const Digest& password, salting scheme = salt_suffix): name_hash(username), salt(salt), pass_hash(password), scheme(scheme){};
+  /**
+   * Új fiókot hoz létre nyers felhasználónévből és jelszóból.
+   * @param username felhasználónév.
+   * @param salt a só.
+   * @param password jelszó.
+   * @param scheme a sózás módja, új fiókoknál alapból só elöl.
+   * @return Account.
+   */
+  static Account create(const String& username, const String& salt, const String& password, salting scheme = salt_prefix);
+  /**
+   * Visszaalakít egy tárolt fiók rekordot.
+   * Verziózott alak: "<verzió>$<név hash>$<jelszó hash>$<só>".
+   * A verzió nélküli, régi "<név hash>$<jelszó hash>$<só>" alakot 1. verzióként (só a végén) olvassa.
+   * A só a rekord végén áll, így tartalmazhat '$' karaktert is. Hibás rekord esetén std::invalid_argument-et dob.
+   * @param record a rekord.
+   * @return Account.
+   */
+  static Account parse(const String& record);
+  /**
+   * Verziózott rekord alakra hozza a fiókot, amit a parse visszaolvas.
+   * @return String.
+   */
+  String serialize() const;
+  /**
+   * Visszaadja a sózás módját.
+   * @return salting.
+   */
+  salting getScheme() const{
+    return scheme;
+  }
+  /**
+   * Előkészíti a fiók sójának midstate-jét tömeges ellenőrzéshez.
+   * Csak só elöl sémájú fióknál értelmes, egyébként std::logic_error-t dob.
+   * @return sha256_prefix.
+   */
+  sha256_prefix prefix() const;
+  /**
+   * Ellenőrzi, hogy a megadott felhasználónév és jelszó a sóval együtt megegyezik-e a fiókban tároltakkal.
+   * Mindkét hash-t kiszámolja és konstans időben hasonlítja össze, így a futásidőből nem derül ki, melyik tért el.
+   * @param username felhasználónév.
+   * @param password jelszó.
+   * @return bool.
    */
-  Account(const String& username = "",const String& salt="", const String& password=""): name_hash(username), salt(salt), pass_hash(password){};
+  bool verify(const String& username, const String& password) const;
   /**
-   * Ellenőrzi, hogy a megadott felhasználónév + só, jelszó + só megegyezik-e a fiókban tároltakkal.
+   * Ellenőrzés egy előre kiszámolt só midstate-ből, sok jelölt ellenőrzéséhez ugyanazzal a sóval.
+   * A salted-nek ennek a fióknak a prefix() hívásából kell származnia.
+   * Csak só elöl sémájú fióknál használható, egyébként std::logic_error-t dob.
+   * @param salted a só midstate-je.
    * @param username felhasználónév.
    * @param password jelszó.
    * @return bool.
    */
-  bool verify(const String& username, const String& password);
+  bool verify(const sha256_prefix& salted, const String& username, const String& password) const;
 };
-
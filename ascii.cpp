@@ -0,0 +1,113 @@
+#include "ascii.h"
+#include "cpu.h"
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(CPU_X86)
+#include <immintrin.h>
+#endif
+
+/**
+ * A kernelek által elvégzett művelet.
+ */
+enum ascii_op{
+  op_check, /**< csak ellenőrzés.*/
+  op_upper, /**< nagybetűsítés.*/
+  op_lower, /**< kisbetűsítés.*/
+  op_check_upper /**< ellenőrzés és nagybetűsítés.*/
+};
+
+/**
+ * A karakterek vizsgálata eltolással: (c - first) előjel nélkül kisebb mint 26 pontosan akkor, ha c a [first, first+25] tartományba esik.
+ * SIMD-ben csak előjeles byte összehasonlítás van, ezért 0x80-nal eltolva a tartomány a [-128, -103] intervallumba kerül.
+ */
+static inline bool in_range(uint8_t c, char first){
+  return (uint8_t)(c - first) < 26;
+}
+static inline bool scalar(const char* src, char* dst, size_t n, ascii_op op){
+  for(size_t i = 0; i < n; ++i){
+    uint8_t c = (uint8_t)src[i];
+    if((op == op_check || op == op_check_upper) && !in_range(c | 0x20, 'a')) return false;
+    if(op == op_check) continue;
+    if(op == op_lower) dst[i] = (char)(in_range(c, 'A') ? c | 0x20 : c);
+    else dst[i] = (char)(in_range(c, 'a') ? c & ~0x20 : c);
+  }
+  return true;
+}
+#if defined(__SSE2__)
+/**
+ * 16 byte-os blokkok feldolgozása, a maradékot (n % 16) nem érinti.
+ */
+static bool sse2(const char* src, char* dst, size_t n, ascii_op op){
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i bias_lower = _mm_set1_epi8((char)(0x80 - 'a'));
+  const __m128i bias_upper = _mm_set1_epi8((char)(0x80 - 'A'));
+  const __m128i limit = _mm_set1_epi8(-128 + 26);
+  for(size_t i = 0; i + 16 <= n; i += 16){
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    if(op == op_check || op == op_check_upper){
+      __m128i alpha = _mm_cmpgt_epi8(limit, _mm_add_epi8(_mm_or_si128(v, case_bit), bias_lower));
+      if(_mm_movemask_epi8(alpha) != 0xffff) return false;
+      if(op == op_check) continue;
+    }
+    __m128i m = _mm_cmpgt_epi8(limit, _mm_add_epi8(v, op == op_lower ? bias_upper : bias_lower));
+    _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(v, _mm_and_si128(m, case_bit)));
+  }
+  return true;
+}
+#endif
+#if defined(CPU_X86)
+/**
+ * 32 byte-os blokkok feldolgozása, a maradékot (n % 32) nem érinti.
+ */
+__attribute__((target("avx2")))
+static bool avx2(const char* src, char* dst, size_t n, ascii_op op){
+  const __m256i case_bit = _mm256_set1_epi8(0x20);
+  const __m256i bias_lower = _mm256_set1_epi8((char)(0x80 - 'a'));
+  const __m256i bias_upper = _mm256_set1_epi8((char)(0x80 - 'A'));
+  const __m256i limit = _mm256_set1_epi8(-128 + 26);
+  for(size_t i = 0; i + 32 <= n; i += 32){
+    __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+    if(op == op_check || op == op_check_upper){
+      __m256i alpha = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(_mm256_or_si256(v, case_bit), bias_lower));
+      if(_mm256_movemask_epi8(alpha) != -1) return false;
+      if(op == op_check) continue;
+    }
+    __m256i m = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(v, op == op_lower ? bias_upper : bias_lower));
+    _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(v, _mm256_and_si256(m, case_bit)));
+  }
+  return true;
+}
+#endif
+/**
+ * A leggyorsabb elérhető kernellel végigmegy a bufferen, a maradékot a keskenyebb kernelekre bízza.
+ */
+static bool run(const char* src, char* dst, size_t n, ascii_op op){
+  size_t done = 0;
+#if defined(CPU_X86)
+  static bool has_avx2 = cpu_has_avx2();
+  if(has_avx2 && n >= 32){
+    if(!avx2(src, dst, n, op)) return false;
+    done = n & ~(size_t)31;
+  }
+#endif
+#if defined(__SSE2__)
+  if(!sse2(src + done, dst + done, n - done, op)) return false;
+  done += (n - done) & ~(size_t)15;
+#endif
+  return scalar(src + done, dst + done, n - done, op);
+}
+
+bool ascii_isalpha(const char* str, size_t n){
+  return run(str, NULL, n, op_check);
+}
+void ascii_toupper(char* str, size_t n){
+  run(str, str, n, op_upper);
+}
+void ascii_tolower(char* str, size_t n){
+  run(str, str, n, op_lower);
+}
+bool ascii_upper_alpha(const char* src, size_t n, char* dst){
+  return run(src, dst, n, op_check_upper);
+}
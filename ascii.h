@@ -0,0 +1,41 @@
+#ifndef ASCII
+#define ASCII
+#include <cstddef>
+/**
+ * @file ascii.h
+ * ASCII karakter osztályozó és kis/nagybetűsítő függvények header fájlja.
+ * A függvények locale-független ASCII szemantikát követnek (csak az angol abc betűit kezelik betűként),
+ * és AVX2-vel 32, SSE2-vel 16 byte-ot dolgoznak fel egyszerre; a maradékot és a többi platformot skalár kód kezeli.
+ * Az AVX2 változatot futásidőben, a processzor képességei alapján választjuk.
+ */
+
+/**
+ * Igaz, ha mind az n karakter az angol abc betűje.
+ * @param str a karakterek.
+ * @param n a karakterek száma.
+ * @return bool.
+ */
+bool ascii_isalpha(const char* str, size_t n);
+/**
+ * Helyben nagybetűsíti az angol abc betűit, a többi byte-ot nem módosítja.
+ * @param str a karakterek.
+ * @param n a karakterek száma.
+ */
+void ascii_toupper(char* str, size_t n);
+/**
+ * Helyben kisbetűsíti az angol abc betűit, a többi byte-ot nem módosítja.
+ * @param str a karakterek.
+ * @param n a karakterek száma.
+ */
+void ascii_tolower(char* str, size_t n);
+/**
+ * Ellenőrzés és nagybetűsítés egy menetben: a src betűit nagybetűsítve dst-be írja.
+ * Ha valamelyik karakter nem az angol abc betűje, hamissal tér vissza, ekkor dst tartalma részben írt, nem használható.
+ * dst lehet ugyanaz mint src (helyben végzett művelet).
+ * @param src a forrás karakterek.
+ * @param n a karakterek száma.
+ * @param dst legalább n byte-os cél buffer.
+ * @return bool igaz, ha minden karakter betű volt.
+ */
+bool ascii_upper_alpha(const char* src, size_t n, char* dst);
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file account_memory_bench.cpp
+ * Memória lábnyom benchmark: egymillió fiók közös sóval, és százezer titkosító objektum közös kulccsal.
+ * A String alapmódban minden másolat saját dinamikus buffert kap, STRING_COW módban a másolatok egy buffert osztanak meg.
+ * A két mód összehasonlításához a programot kétszer kell lefordítani, egyszer -DSTRING_COW kapcsolóval.
+ * Az eredményt (élő heap byte-ok, foglalások száma) JSON-ként írja a standard outputra.
+ *
+ * Fordítás (a repó gyökeréből):
+ *   g++ -std=c++17 -O2 [-DSTRING_COW] -o account_memory_bench bench/account_memory_bench.cpp account.cpp cipher.cpp sha256.cpp sha256_kernel.cpp digest.cpp string.cpp stringview.cpp ascii.cpp format.cpp cpu.cpp
+ * Használat:
+ *   ./account_memory_bench [fiokok_szama]
+ */
+#include "../account.h"
+#include "../cipher.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+
+/**
+ * Az éppen lefoglalt heap byte-ok száma (glibc).
+ */
+static size_t heap_in_use(){
+  struct mallinfo2 mi = mallinfo2();
+  return mi.uordblks + mi.hblkhd;
+}
+
+int main(int argc, char** argv){
+  size_t accounts = 1000000;
+  if(argc > 1) accounts = strtoull(argv[1], NULL, 10);
+  size_t ciphers = accounts / 10;
+
+#if defined(STRING_COW)
+  const char* mode = "cow";
+#else
+  const char* mode = "copy";
+#endif
+  /**
+   * Egy 32 byte-os só és egy 40 byte-os kulcs, mindkettő hosszabb a String belső bufferénél, így dinamikusan tárolódik.
+   */
+  String salt("0f1e2d3c4b5a69788796a5b4c3d2e1f0");
+  String key("kozos-titkositasi-kulcs-sok-objektumnak");
+
+  size_t h0 = heap_in_use();
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  Vector<Account> records(accounts);
+  size_t h1 = heap_in_use();
+  Digest name, pass;
+  for(size_t i = 0; i < accounts; ++i){
+    name.data()[0] = (uint8_t)i;
+    pass.data()[0] = (uint8_t)(i >> 8);
+    records[i] = Account(name, salt, pass, salt_prefix);
+  }
+  double account_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  size_t h2 = heap_in_use();
+
+  XOR** xors = new XOR*[ciphers];
+  for(size_t i = 0; i < ciphers; ++i){
+    xors[i] = new XOR(key);
+  }
+  size_t h3 = heap_in_use();
+
+  printf("{\n  \"mode\": \"%s\",\n  \"string_size\": %zu,\n  \"account_size\": %zu,\n", mode, sizeof(String), sizeof(Account));
+  printf("  \"accounts\": %zu,\n  \"account_array_bytes\": %zu,\n  \"account_salt_heap_bytes\": %zu,\n  \"account_fill_secs\": %.3f,\n",
+         accounts, h1 - h0, h2 - h1, account_secs);
+  printf("  \"xor_ciphers\": %zu,\n  \"xor_heap_bytes\": %zu,\n  \"xor_heap_bytes_per_object\": %.1f\n}\n",
+         ciphers, h3 - h2, (double)(h3 - h2) / (ciphers ? ciphers : 1));
+
+  for(size_t i = 0; i < ciphers; ++i){
+    delete xors[i];
+  }
+  delete[] xors;
+  return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file sha256_bench.cpp
+ * SHA256 mikro-benchmark.
+ * Kernelenként (scalar, shani) méri a ciklus/byte és MB/s értékeket 0 byte-tól 1 GiB-ig,
+ * valamint az egy blokkos üzenetek/másodperc értékét egyesével, kötegelten (sha256_many, az általa választott úton)
+ * és AVX2-es processzoron közvetlenül a 8 lane-es kernellel (sha256_many_x8), akkor is, ha a sha256_many SHA-NI miatt nem azt választja.
+ * Az eredményt JSON-ként írja a standard outputra, hogy regressziók gépileg összehasonlíthatók legyenek.
+ *
+ * Fordítás (a repó gyökeréből):
+ *   g++ -std=c++17 -O2 -o sha256_bench bench/sha256_bench.cpp sha256.cpp sha256_kernel.cpp digest.cpp string.cpp stringview.cpp ascii.cpp format.cpp cpu.cpp
+ * Használat:
+ *   ./sha256_bench [max_meret_byte] [min_ido_ms]
+ */
+#include "../sha256.h"
+#include "../sha256_kernel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Időbélyeg ciklusokban (x86-on a TSC), máshol 0.
+ */
+static uint64_t cycles(){
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+static double seconds_since(std::chrono::steady_clock::time_point t0){
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+/**
+ * Megakadályozza, hogy a fordító kioptimalizálja a mért számítást.
+ */
+static volatile uint8_t sink;
+
+/**
+ * Egy mérés eredménye.
+ */
+struct Result{
+  uint64_t iterations; /**< a mért hívások száma.*/
+  double secs; /**< a mérés teljes ideje.*/
+  double cyc; /**< a mérés teljes ideje ciklusokban.*/
+};
+
+/**
+ * Egy size byte-os üzenet hashelése, legalább min_secs ideig ismételve.
+ * Kis üzeneteknél több hívást mérünk egy óra lekérdezés között, hogy az óra költsége ne torzítson.
+ */
+static Result bench_size(const uint8_t* data, size_t size, double min_secs){
+  Result r = {0, 0, 0};
+  size_t batch = 65536 / (size + 64) + 1;
+  sink = sha256(data, size).finalize()[0]; // bemelegítés
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  uint64_t c0 = cycles();
+  do{
+    for(size_t i = 0; i < batch; ++i){
+      sink = sha256(data, size).finalize()[0];
+    }
+    r.iterations += batch;
+    r.secs = seconds_since(t0);
+  }while(r.secs < min_secs);
+  r.cyc = (double)(cycles() - c0);
+  return r;
+}
+/**
+ * Az egy blokkos üzenetek hashelésének módja.
+ */
+enum Mode{
+  SINGLE, /**< egyesével, sha256 objektummal.*/
+  MANY, /**< kötegelten, a sha256_many által választott úton.*/
+  X8 /**< 8-asával, közvetlenül a sha256_many_x8-cal.*/
+};
+/**
+ * Egy blokkos (55 byte-os) üzenetek hashelése a megadott módon. Az X8 módhoz a count 8-cal osztható kell legyen.
+ */
+static Result bench_messages(const uint8_t* data, size_t count, Mode mode, double min_secs){
+  sha256_message* msgs = new sha256_message[count];
+  Digest* out = new Digest[count];
+  for(size_t i = 0; i < count; ++i){
+    msgs[i].data = data + i;
+    msgs[i].len = 55;
+  }
+  Result r = {0, 0, 0};
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  uint64_t c0 = cycles();
+  do{
+    if(mode == MANY) sha256_many(msgs, count, out);
+#if defined(CPU_X86)
+    else if(mode == X8){
+      for(size_t i = 0; i < count; i += 8) sha256_many_x8(msgs + i, out + i);
+    }
+#endif
+    else{
+      for(size_t i = 0; i < count; ++i){
+        out[i] = sha256(msgs[i].data, msgs[i].len).finalize();
+      }
+    }
+    sink = out[count - 1][0];
+    r.iterations += count;
+    r.secs = seconds_since(t0);
+  }while(r.secs < min_secs);
+  r.cyc = (double)(cycles() - c0);
+  delete[] msgs;
+  delete[] out;
+  return r;
+}
+
+int main(int argc, char** argv){
+  size_t max_size = (size_t)1 << 30;
+  double min_secs = 0.2;
+  if(argc > 1) max_size = strtoull(argv[1], NULL, 10);
+  if(argc > 2) min_secs = atof(argv[2]) / 1000.0;
+
+  struct Kernel{ const char* name; sha256_compress_fn fn; };
+  Kernel kernels[2];
+  size_t nkernels = 0;
+  kernels[nkernels++] = Kernel{"scalar", sha256_compress_scalar};
+#if defined(SHA256_HAVE_SHANI)
+  if(cpu_has_shani()) kernels[nkernels++] = Kernel{"shani", sha256_compress_shani};
+#endif
+  bool avx2 = false;
+#if defined(SHA256_HAVE_AVX2)
+  avx2 = cpu_has_avx2();
+#endif
+  sha256_compress_fn selected = sha256_compress;
+
+  uint8_t* data = (uint8_t*)malloc(max_size > 4096 ? max_size : 4096);
+  if(data == NULL){
+    fprintf(stderr, "Nem sikerult %zu byte-ot foglalni!\n", max_size);
+    return 1;
+  }
+  for(size_t i = 0; i < (max_size > 4096 ? max_size : 4096); ++i) data[i] = (uint8_t)(i*131 + 7);
+
+  printf("{\n  \"default_kernel\": \"%s\",\n  \"many_path\": \"%s\",\n  \"avx2\": %s,\n  \"sizes\": [",
+         sha256_kernel_name(), sha256_many_path(), avx2 ? "true" : "false");
+  bool first = true;
+  for(size_t k = 0; k < nkernels; ++k){
+    sha256_compress = kernels[k].fn;
+    for(size_t size = 0; size <= max_size; size = (size == 0) ? 64 : size*4){
+      Result r = bench_size(data, size, min_secs);
+      double bytes = (double)size * r.iterations;
+      printf("%s\n    {\"kernel\": \"%s\", \"bytes\": %zu, \"iterations\": %llu, \"ns_per_op\": %.2f, \"cycles_per_op\": %.1f, ",
+             first ? "" : ",", kernels[k].name, size, (unsigned long long)r.iterations, r.secs*1e9 / r.iterations, r.cyc / r.iterations);
+      if(size > 0) printf("\"cycles_per_byte\": %.3f, \"mb_per_s\": %.1f}", r.cyc / bytes, bytes / r.secs / 1e6);
+      else printf("\"cycles_per_byte\": null, \"mb_per_s\": null}");
+      first = false;
+      if(size > max_size / 4) break;
+    }
+  }
+  printf("\n  ],\n  \"single_block\": [");
+  first = true;
+  const size_t count = 1024;
+  for(size_t k = 0; k < nkernels; ++k){
+    sha256_compress = kernels[k].fn;
+    Result r = bench_messages(data, count, SINGLE, min_secs);
+    printf("%s\n    {\"mode\": \"%s\", \"messages_per_s\": %.0f, \"cycles_per_message\": %.1f}",
+           first ? "" : ",", kernels[k].name, r.iterations / r.secs, r.cyc / r.iterations);
+    first = false;
+  }
+  sha256_compress = selected;
+  Result r = bench_messages(data, count, MANY, min_secs);
+  printf(",\n    {\"mode\": \"many_%s\", \"messages_per_s\": %.0f, \"cycles_per_message\": %.1f}",
+         sha256_many_path(), r.iterations / r.secs, r.cyc / r.iterations);
+  if(avx2){
+    r = bench_messages(data, count, X8, min_secs);
+    printf(",\n    {\"mode\": \"x8_avx2\", \"messages_per_s\": %.0f, \"cycles_per_message\": %.1f}",
+           r.iterations / r.secs, r.cyc / r.iterations);
+  }
+  printf("\n  ]\n}\n");
+  free(data);
+  return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file string_alloc_bench.cpp
+ * String allokáció számláló benchmark.
+ * A globális new/delete operátorokat lecserélve megszámolja, hány dinamikus foglalás történik
+ * a beléptetés (Account::verify, Account::parse) és a titkosítók (encode/decode) egy-egy hívásában,
+ * valamint méri a hívások idejét. Az eredményt JSON-ként írja a standard outputra.
+ *
+ * Fordítás (a repó gyökeréből):
+ *   g++ -std=c++17 -O2 -o string_alloc_bench bench/string_alloc_bench.cpp account.cpp cipher.cpp sha256.cpp sha256_kernel.cpp digest.cpp string.cpp stringview.cpp ascii.cpp format.cpp cpu.cpp
+ * Használat:
+ *   ./string_alloc_bench [ismetlesek]
+ */
+#include "../account.h"
+#include "../cipher.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static size_t allocations = 0; /**< az eddigi dinamikus foglalások száma.*/
+static size_t allocated_bytes = 0; /**< az eddig foglalt byte-ok száma.*/
+
+void* operator new(size_t n){
+  ++allocations;
+  allocated_bytes += n;
+  void* p = malloc(n ? n : 1);
+  if(p == NULL) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t n){
+  return operator new(n);
+}
+/**
+ * Az igazított változatok (pl. a 64 byte-ra igazított Ciphertext) is számolódnak.
+ */
+void* operator new(size_t n, std::align_val_t al){
+  ++allocations;
+  allocated_bytes += n;
+  void* p = aligned_alloc((size_t)al, (n + (size_t)al - 1) & ~((size_t)al - 1));
+  if(p == NULL) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t n, std::align_val_t al){
+  return operator new(n, al);
+}
+void operator delete(void* p, std::align_val_t) noexcept{
+  free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept{
+  free(p);
+}
+void operator delete(void* p, size_t, std::align_val_t) noexcept{
+  free(p);
+}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept{
+  free(p);
+}
+void operator delete(void* p) noexcept{
+  free(p);
+}
+void operator delete[](void* p) noexcept{
+  free(p);
+}
+void operator delete(void* p, size_t) noexcept{
+  free(p);
+}
+void operator delete[](void* p, size_t) noexcept{
+  free(p);
+}
+
+/**
+ * Megakadályozza, hogy a fordító kioptimalizálja a mért számítást.
+ */
+static volatile size_t sink;
+
+/**
+ * Egy mért útvonal: az iterations hívás alatt történt foglalások és az eltelt idő.
+ */
+template<typename F>
+static void measure(const char* name, size_t iterations, bool& first, F f){
+  f(); // bemelegítés
+  size_t a0 = allocations;
+  size_t b0 = allocated_bytes;
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < iterations; ++i){
+    f();
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("%s\n    {\"path\": \"%s\", \"allocations_per_op\": %.2f, \"bytes_per_op\": %.1f, \"ns_per_op\": %.1f}",
+         first ? "" : ",", name, (double)(allocations - a0) / iterations, (double)(allocated_bytes - b0) / iterations, secs*1e9 / iterations);
+  first = false;
+}
+
+int main(int argc, char** argv){
+  size_t iterations = 100000;
+  if(argc > 1) iterations = strtoull(argv[1], NULL, 10);
+
+  const char* record = "ca659234fe3bceeb51e1b4a0c01e43ae54180bf4a715858bebf6fe6277b3a939$0a90f84cd8fadb7b4a71c62db57b0d237a8fcf606ea1e61e3cc1980e04ad94db$s\xc3\xb3";
+  Account fiok("ca659234fe3bceeb51e1b4a0c01e43ae54180bf4a715858bebf6fe6277b3a939", "s\xc3\xb3", "0a90f84cd8fadb7b4a71c62db57b0d237a8fcf606ea1e61e3cc1980e04ad94db");
+  XOR x("kulcs");
+  Vigenere v("KULCS");
+  Bifid b("KULCS");
+  String rovid("TitkosUzenet");
+  String hosszu;
+  for(size_t i = 0; i < 16; ++i) hosszu += "EzEgyHosszabbUzenet";
+  Ciphertext xr = x.encode(rovid), vr = v.encode(rovid), br = b.encode(rovid);
+
+  printf("{\n  \"sso_capacity\": %zu,\n  \"iterations\": %zu,\n  \"paths\": [", (size_t)String::sso_capacity, iterations);
+  bool first = true;
+  measure("account_verify", iterations, first, [&]{ sink = fiok.verify("Valentin", "almafa12"); });
+  measure("account_parse_verify", iterations, first, [&]{ sink = Account::parse(record).verify("Valentin", "almafa12"); });
+  measure("string_concat_short", iterations, first, [&]{ String s = String("Valentin") + "s\xc3\xb3"; sink = s.getLength(); });
+  measure("xor_roundtrip_short", iterations, first, [&]{ sink = x.decode(x.encode(rovid)).getLength(); });
+  measure("xor_decode_short", iterations, first, [&]{ sink = x.decode(xr).getLength(); });
+  measure("vigenere_decode_short", iterations, first, [&]{ sink = v.decode(vr).getLength(); });
+  measure("bifid_decode_short", iterations, first, [&]{ sink = b.decode(br).getLength(); });
+  measure("xor_roundtrip_304", iterations / 10 + 1, first, [&]{ sink = x.decode(x.encode(hosszu)).getLength(); });
+  printf("\n  ]\n}\n");
+  return 0;
+}
@@ -1,61 +1,98 @@
 #include "cipher.h"
 #include "string.h"
+#include "ascii.h"
+#include "smallvector.hpp"
 #include <cstdint>
+#include <cstring>
 #include <iostream>
-XOR::XOR(const String& key): key(key){}
-String XOR::decode(const Vector<uint8_t>& ciphertext) const{
-  String res;
-  size_t key_len = key.getLength();
-  size_t text_len = ciphertext.size();
-  char c;
-  for(size_t x = 0; x<text_len; ++x){
-    c = ciphertext[x]^key[x%key_len];
-    res += c;
+/**
+ * out[i] = in[i] ^ key[i % key_len], n byte-ra.
+ * A rövid kulcsot egy legfeljebb 256 byte-os blokkba ismételjük, így a belső ciklus modulo és ellenőrzés nélküli,
+ * hosszú, folytonos XOR két pointer között, amit a fordító vektorizál.
+ */
+static void xor_keystream(const uint8_t* in, size_t n, const uint8_t* key, size_t key_len, uint8_t* out){
+  if(n == 0) return;
+  uint8_t block[256];
+  if(key_len < sizeof(block) && n <= 2*sizeof(block)){
+    /**
+     * Rövid szövegnél a blokk feltöltése többe kerülne, mint maga a XOR.
+     */
+    for(size_t i = 0, j = 0; i < n; ++i){
+      out[i] = in[i] ^ key[j];
+      if(++j == key_len) j = 0;
+    }
+    return;
+  }
+  const uint8_t* ks = key;
+  size_t ks_len = key_len;
+  if(key_len < sizeof(block)){
+    memcpy(block, key, key_len);
+    for(ks_len = key_len; 2*ks_len <= sizeof(block); ks_len *= 2){
+      memcpy(block + ks_len, block, ks_len);
+    }
+    ks = block;
+  }
+  while(n > 0){
+    size_t m = n < ks_len ? n : ks_len;
+    for(size_t j = 0; j < m; ++j){
+      out[j] = in[j] ^ ks[j];
+    }
+    in += m;
+    out += m;
+    n -= m;
   }
-  return res;
 }
-Vector<uint8_t> XOR::encode(const String& plaintext)const{
-  Vector<uint8_t> res(plaintext.getLength());
-  size_t key_len = key.getLength();
+XOR::XOR(const String& key): key(key){
+  if(key.getLength() == 0) throw std::invalid_argument("Üres kulccsal nem működik!");
+}
+String XOR::decode(Span<const uint8_t> ciphertext) const{
+  size_t text_len = ciphertext.size();
+  StringBuilder res(text_len);
+  xor_keystream(ciphertext.data(), text_len, (const uint8_t*)key.c_string(), key.getLength(), (uint8_t*)res.append_uninitialized(text_len));
+  return res.str();
+}
+Ciphertext XOR::encode(const StringView& plaintext)const{
   size_t text_len = plaintext.getLength();
-  for(size_t x = 0; x<text_len; ++x){
-    res[x] = plaintext[x]^key[x%key_len];
-  }
+  Ciphertext res = Ciphertext::for_overwrite(text_len);
+  xor_keystream((const uint8_t*)plaintext.data(), text_len, (const uint8_t*)key.c_string(), key.getLength(), res.data());
   return res;
 }
 
-Vigenere::Vigenere(const String& _key){
-  if(!_key.isalpha()) throw std::invalid_argument("Csak alfanumerikus kulccsal működik!");
-  key = _key;
-  key.toUpper();
+Vigenere::Vigenere(const String& _key): key(_key){
+  if(!key.toUpperAlpha()) throw std::invalid_argument("Csak alfanumerikus kulccsal működik!");
 }
-Vector<uint8_t> Vigenere::encode(const String& plaintext) const{
-  if(!plaintext.isalpha()) throw std::invalid_argument("Csak alfanumerikus szöveggel működik!");
-  String plainUp = plaintext;
-  Vector<uint8_t> res(plaintext.getLength());
+Ciphertext Vigenere::encode(const StringView& plaintext) const{
+  Ciphertext res = Ciphertext::for_overwrite(plaintext.getLength());
   size_t key_len = key.getLength();
   size_t text_len = plaintext.getLength();
-  plainUp.toUpper();
-  for(size_t x = 0; x<text_len; ++x){
-    res[x] = 'A' + (plainUp[x]-'A' + key[x%key_len]-'A')%26;
+  /**
+   * Ellenőrzés és nagybetűsítés egy menetben, egyenesen a kimeneti bufferbe, amit utána helyben titkosítunk.
+   */
+  if(!ascii_upper_alpha(plaintext.data(), text_len, (char*)res.data())){
+    throw std::invalid_argument("Csak alfanumerikus szöveggel működik!");
+  }
+  uint8_t* out = res.data();
+  const char* k = key.c_string();
+  for(size_t x = 0, y = 0; x<text_len; ++x){
+    out[x] = 'A' + (out[x]-'A' + k[y]-'A')%26;
+    if(++y == key_len) y = 0;
   }
   return res;
 }
-String Vigenere::decode(const Vector<uint8_t>& ciphertext) const{
-  String res;
+String Vigenere::decode(Span<const uint8_t> ciphertext) const{
   size_t key_len = key.getLength();
   size_t text_len = ciphertext.size();
+  StringBuilder res(text_len);
   char c;
   for(size_t x = 0; x<text_len; ++x){
     c = 'A' + (ciphertext[x]-'A' + (26 - (key[x%key_len]-'A')))%26;
-    res += c;
+    res.append(c);
   }
-  return res;
+  return res.str();
 }
 Bifid::Bifid(const String& _key){
-  if(!_key.isalpha()) throw std::invalid_argument("Csak alfanumerikus kulccsal működik!");
   String tmp = _key;
-  tmp.toUpper();
+  if(!tmp.toUpperAlpha()) throw std::invalid_argument("Csak alfanumerikus kulccsal működik!");
   String used('J');
   int x = 0;
   int y = 0;
@@ -85,16 +122,22 @@ Bifid::Point Bifid::find_it(char c) const{
   } 
   return Point(5,5);
 }
-Vector<uint8_t> Bifid::encode(const String& plaintext) const{
-  if(!plaintext.isalpha()) throw std::invalid_argument("Csak alfanumerikus szöveggel működik!");
-  String plainUp = plaintext;
-  Vector<uint8_t> res(plaintext.getLength());
+Ciphertext Bifid::encode(const StringView& plaintext) const{
+  Ciphertext res = Ciphertext::for_overwrite(plaintext.getLength());
   size_t text_len = plaintext.getLength();
-  plainUp.toUpper();
-  Vector<size_t> idx(text_len*2);
+  /**
+   * A nagybetűsített szöveget ideiglenesen a kimeneti bufferbe írjuk, az indexek kiszámolása után felülírjuk.
+   */
+  if(!ascii_upper_alpha(plaintext.data(), text_len, (char*)res.data())){
+    throw std::invalid_argument("Csak alfanumerikus szöveggel működik!");
+  }
+  /**
+   * A koordináták 0..5 közöttiek, elférnek egy byte-on; rövid szövegnél a segédtömb nem foglal memóriát.
+   */
+  SmallVector<uint8_t, 512> idx = SmallVector<uint8_t, 512>::for_overwrite(text_len*2);
   Point tmp;
   for(size_t i = 0; i < text_len; ++i){
-    tmp = find_it(plainUp[i]);
+    tmp = find_it(res[i]);
     idx[i] = tmp.y;
     idx[text_len+i] = tmp.x;
   }
@@ -103,11 +146,14 @@ Vector<uint8_t> Bifid::encode(const String& plaintext) const{
   }
   return res;
 }
-String Bifid::decode(const Vector<uint8_t>& ciphertext) const{
-  String res;
+String Bifid::decode(Span<const uint8_t> ciphertext) const{
   size_t text_len = ciphertext.size();
+  StringBuilder res(text_len);
   char c;
-  Vector<size_t> idx(text_len*2);
+  /**
+   * A koordináták 0..5 közöttiek, elférnek egy byte-on; rövid szövegnél a segédtömb nem foglal memóriát.
+   */
+  SmallVector<uint8_t, 512> idx = SmallVector<uint8_t, 512>::for_overwrite(text_len*2);
   Point tmp;
   for(size_t i = 0; i < text_len; ++i){
     tmp = find_it(ciphertext[i]);
@@ -116,7 +162,7 @@ String Bifid::decode(const Vector<uint8_t>& ciphertext) const{
   }
   for(size_t i = 0; i < text_len; ++i){
     c = key[idx[i]][idx[text_len+i]];
-    res += c;
+    res.append(c);
   }
-  return res;
+  return res.str();
 }
@@ -7,6 +7,12 @@
  *  A titkosító osztályok header fájlja.
 */
 
+/**
+ * A titkosítók kimenete: byte tömb, cache line (64 byte) határra igazított memóriában,
+ * így a ráépülő SIMD feldolgozás (pl. hash, további kódolás) igazított betöltésekkel kezdhet.
+ */
+typedef Vector<uint8_t, Align<64>> Ciphertext;
+
 /**
  * Absztakt osztály amely összeköti a különböző tikosítási osztályokat.
  * A titkosítási módszereknek közös metódusait köti össze örökléssel, de
@@ -17,16 +23,18 @@ class Cipher{
  /**
   * Tisztán virtuális függvény amely az enkódolásért felelős.
   * Különböző titkosítási módoknál, különböző enkódolási algoritmusok érvényesülnek.
-  * @param plaintext egy String típusú titkosítandó szöveg.
+  * A szöveget nézetként kapja, így String, C-sztring és MappedText (memóriába leképezett fájl) is átadható másolás nélkül.
+  * @param plaintext a titkosítandó szöveg nézete.
+  * @return Ciphertext a titkosított byte-ok, 64 byte-os határra igazítva.
   */
- virtual Vector<uint8_t> encode(const String& plaintext) const = 0;
+ virtual Ciphertext encode(const StringView& plaintext) const = 0;
 
  /**
   * Tisztán virtuális függvény amely a dekódolásért felelős.
   * Különböző titkosítási módoknál, különböző dekódolási algoritmusok érvényesülnek.
-  * @param ciphertext egy Vector<uint8_t> típusú tároló amelynek elemeit dekódolni szeretnénk. Azért Vector<uint8_t> mert a titkosított szöveg legtöbb esetben nem tárolható Stringként, mert nem felel meg a formátuma (pl. NULL érték információt képvisel nem pedig lezáró karaktert).
+  * @param ciphertext a dekódolandó byte-ok nézete (Ciphertext, Vector<uint8_t> vagy nyers buffer). Azért byte-ok, mert a titkosított szöveg legtöbb esetben nem tárolható Stringként, mert nem felel meg a formátuma (pl. NULL érték információt képvisel nem pedig lezáró karaktert).
   */
- virtual String decode(const Vector<uint8_t>& ciphertext) const = 0;
+ virtual String decode(Span<const uint8_t> ciphertext) const = 0;
  /**
   * Virtuális destruktor.
   */
@@ -44,22 +52,23 @@ class XOR: public Cipher{
   public:
  /**
   * Konstruktor
+  * Üres kulccsal nem működik, ekkor std::invalid_argument kivételt dob.
   */
  XOR(const String&);
 
  /**
   * Enkódoló függvény, amely plaintextet titkosítja XOR-ral.
-  * @return Vector<uint8_t> mivel a XOR szinte mindig elrontja a String formátumát, ezért minden tiktosítandó karaktert uint8_t-ként kezelünk és adunk is tovább titkosítva.
-  * @param plaintext titkosítandó String típusú szöveg.
+  * @return Ciphertext mivel a XOR szinte mindig elrontja a String formátumát, ezért minden tiktosítandó karaktert uint8_t-ként kezelünk és adunk is tovább titkosítva.
+  * @param plaintext a titkosítandó szöveg nézete.
   */
- Vector<uint8_t> encode(const String& plaintext) const;
+ Ciphertext encode(const StringView& plaintext) const;
 
  /**
   * Dekódoló függvény, amely ciphertext titkosítását oldja föl.
   * @return  String
-  * @param ciphertext feloldandó Vector<uint8_t> típusú tároló.
+  * @param ciphertext a feloldandó byte-ok nézete.
   */
- String decode(const Vector<uint8_t>& ciphertext) const;
+ String decode(Span<const uint8_t> ciphertext) const;
 
  /**
   * Destruktor
@@ -86,14 +95,14 @@ class Vigenere: public Cipher{
   * @param ciphertext.
   * @return String.
   */
- String decode(const Vector<uint8_t>&)const; 
+ String decode(Span<const uint8_t>)const; 
  /**
   * Enkódoló függvény.
   * Ez végzi az egymásutáni ABC shiftelést a kulcs alapján, így titkosítva a szöveget.
   * @param plaintext.
-  * @return Vector<uint8_t> annak ellenére, hogy itt biztosan szövegként térne vissza, egyszerűbb generikusan így kezelni a titkosításokat. Ez nem fog különösebb problémát okozni mivel ha tudjuk, hogy a Vector<uint8_t> elemei ASCII karakterek, akkor a Vector<uint8_t> -> String konverzió egyszerű.
+  * @return Ciphertext annak ellenére, hogy itt biztosan szövegként térne vissza, egyszerűbb generikusan így kezelni a titkosításokat. Ez nem fog különösebb problémát okozni mivel ha tudjuk, hogy a Ciphertext elemei ASCII karakterek, akkor a Ciphertext -> String konverzió egyszerű.
   */
- Vector<uint8_t> encode(const String&)const;
+ Ciphertext encode(const StringView&)const;
  /**
   * Destruktor.
   */
@@ -150,14 +159,14 @@ class Bifid: public Cipher{
   * @param ciphertext.
   * @return String.
   */
- String decode(const Vector<uint8_t>&)const; 
+ String decode(Span<const uint8_t>)const; 
  /**
   * Enkódoló függvény.
   * Ez végzi a tikosítás visszafejtését.
   * @param plaintext.
-  * @return Vector<uint8_t> annak ellenére, hogy itt biztosan szövegként térne vissza, egyszerűbb generikusan így kezelni a titkosításokat. Ez nem fog különösebb problémát okozni mivel ha tudjuk, hogy a Vector<uint8_t> elemei ASCII karakterek, akkor a Vector<uint8_t> -> String konverzió egyszerű.
+  * @return Ciphertext annak ellenére, hogy itt biztosan szövegként térne vissza, egyszerűbb generikusan így kezelni a titkosításokat. Ez nem fog különösebb problémát okozni mivel ha tudjuk, hogy a Ciphertext elemei ASCII karakterek, akkor a Ciphertext -> String konverzió egyszerű.
   */
- Vector<uint8_t> encode(const String&)const;
+ Ciphertext encode(const StringView&)const;
  /**
   * Destruktor.
   */
@@ -0,0 +1,25 @@
+#include "cpu.h"
+#if defined(CPU_X86)
+#include <cpuid.h>
+
+bool cpu_has_shani(){
+  unsigned int eax, ebx, ecx, edx;
+  if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+  bool ssse3 = ecx & (1u << 9);
+  bool sse41 = ecx & (1u << 19);
+  if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+  bool sha = ebx & (1u << 29);
+  return ssse3 && sse41 && sha;
+}
+
+bool cpu_has_avx2(){
+  unsigned int eax, ebx, ecx, edx;
+  if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+  if(!(ecx & (1u << 27)) || !(ecx & (1u << 28))) return false; // OSXSAVE, AVX
+  unsigned int xcr0_lo, xcr0_hi;
+  __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+  if((xcr0_lo & 0x6) != 0x6) return false; // az OS menti az xmm és ymm regisztereket
+  if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+  return ebx & (1u << 5);
+}
+#endif
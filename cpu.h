@@ -0,0 +1,22 @@
+#ifndef CPU
+#define CPU
+/**
+ * @file cpu.h
+ * A processzor képességeinek (CPUID) lekérdezése.
+ * Az SHA256 kernelek, az ASCII és a formázó SIMD függvények ez alapján választanak futásidőben megvalósítást.
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+/**
+ * Megnézi, hogy a processzor támogatja-e a SHA-NI kernelhez szükséges utasításokat (SHA, SSSE3, SSE4.1).
+ * @return bool.
+ */
+bool cpu_has_shani();
+/**
+ * Megnézi, hogy a processzor és az operációs rendszer támogatja-e az AVX2-t (ymm regiszterek mentése is).
+ * @return bool.
+ */
+bool cpu_has_avx2();
+#endif
+#endif
@@ -0,0 +1,21 @@
+#include "digest.h"
+#include "format.h"
+#include <cstring>
+#include <stdexcept>
+
+Digest::Digest(const uint8_t* src){
+  memcpy(bytes, src, size);
+}
+void Digest::hex(char* out) const{
+  to_hex(bytes, size, out);
+  out[2*size] = '\0';
+}
+String Digest::hex() const{
+  char out[2*size+1];
+  hex(out);
+  return String(out);
+}
+Digest Digest::fromHex(const String& hexstr){
+  if(hexstr.getLength() != 2*size) throw std::invalid_argument("A hash hexadecimális alakja 64 karakter hosszú!");
+  return fromHex(hexstr.c_string());
+}
@@ -0,0 +1,119 @@
+#ifndef DIGEST
+#define DIGEST
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "string.h"
+/**
+ * @file digest.h
+ * A Digest osztály header fájlja.
+ */
+
+/**
+ * 32 byte-os bináris hash érték (SHA256 kimenet).
+ * Fix méretű érték típus, a byte-okat helyben tárolja, így létrehozása és másolása nem foglal dinamikus memóriát.
+ * Hexadecimális alakra csak kifejezett kérésre (hex(), fromHex()) alakítjuk.
+ */
+class Digest{
+  uint8_t bytes[32]; /**< a hash byte-jai big endian sorrendben, ahogy az SHA256 kiadja.*/
+  /**
+   * Egy hexadecimális karakter értéke, vagy -1 ha nem hexadecimális számjegy.
+   */
+  static constexpr int hex_value(char c){
+    return (c >= '0' && c <= '9') ? c - '0' :
+           (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+           (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+  }
+  public:
+  static const size_t size = 32; /**< a hash mérete byte-ban.*/
+  /**
+   * Paraméter nélküli konstruktor.
+   * Csupa 0 byte-tal inicializál.
+   */
+  constexpr Digest(): bytes(){}
+  /**
+   * Konstruktor.
+   * @param src legalább 32 byte-os buffer, amiből a hash-t átmásoljuk.
+   */
+  explicit Digest(const uint8_t* src);
+  /**
+   * Visszadja read-only-ként a byte-ok tömbjét.
+   * @return const uint8_t*.
+   */
+  constexpr const uint8_t* data() const{
+    return bytes;
+  }
+  /**
+   * Visszadja írhatóként a byte-ok tömbjét.
+   * @return uint8_t*.
+   */
+  constexpr uint8_t* data(){
+    return bytes;
+  }
+  /**
+   * Indexelő operátor, ellenőrzés nélkül (a méret fix).
+   * @param idx index, 0..31.
+   * @return uint8_t.
+   */
+  constexpr uint8_t operator[](size_t idx) const{
+    return bytes[idx];
+  }
+  /**
+   * Konstans idejű összehasonlítás.
+   * Mindig mind a 32 byte-ot megvizsgálja, így a futásidőből nem derül ki, hányadik byte-nál tér el a két hash.
+   * @param other a másik hash.
+   * @return bool.
+   */
+  constexpr bool operator==(const Digest& other) const{
+    uint8_t diff = 0;
+    for(size_t i = 0; i < size; ++i){
+      diff |= bytes[i] ^ other.bytes[i];
+    }
+    return diff == 0;
+  }
+  /**
+   * Konstans idejű, negált összehasonlítás.
+   * @param other a másik hash.
+   * @return bool.
+   */
+  constexpr bool operator!=(const Digest& other) const{
+    return !(*this == other);
+  }
+  /**
+   * Hexadecimális (kisbetűs, 64 karakteres) alakra hozza a hash-t.
+   * @param out legalább 65 byte-os buffer, a végére '\0' kerül.
+   */
+  void hex(char* out) const;
+  /**
+   * Hexadecimális (kisbetűs, 64 karakteres) alakra hozza a hash-t.
+   * @return String.
+   */
+  String hex() const;
+  /**
+   * Hexadecimális alakból visszaalakít.
+   * Kis- és nagybetűt is elfogad, hibás hossz vagy karakter esetén exceptiont dob.
+   * @param hexstr 64 karakteres hexadecimális String.
+   * @return Digest.
+   */
+  static Digest fromHex(const String& hexstr);
+  /**
+   * Hexadecimális alakból visszaalakít, C-sztringből.
+   * constexpr, így fordítási időben is kiértékelhető: ekkor egy elgépelt literál fordítási hibát okoz.
+   * @param hexstr 64 karakteres, '\0'-val lezárt hexadecimális karaktertömb.
+   * @return Digest.
+   */
+  static constexpr Digest fromHex(const char* hexstr){
+    size_t len = 0;
+    while(hexstr[len] != '\0') ++len;
+    if(len != 2*size) throw std::invalid_argument("A hash hexadecimális alakja 64 karakter hosszú!");
+    Digest res;
+    for(size_t i = 0; i < size; ++i){
+      int hi = hex_value(hexstr[2*i]);
+      int lo = hex_value(hexstr[2*i+1]);
+      if(hi < 0 || lo < 0) throw std::invalid_argument("Nem hexadecimális karakter a hash-ben!");
+      res.bytes[i] = (uint8_t)((hi << 4) | lo);
+    }
+    return res;
+  }
+};
+#endif
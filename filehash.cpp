@@ -0,0 +1,89 @@
+#include "filehash.h"
+#include "mappedfile.h"
+#include "sha256.h"
+#include "vector.hpp"
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+Digest sha256_file(const char* path){
+  MappedFile file(path);
+  file.hint_sequential();
+  sha256 ctx(file.data(), file.size());
+  return ctx.finalize();
+}
+
+/**
+ * Egy levél hash-e: SHA256(levél || 0x00).
+ */
+static Digest leaf_hash(const uint8_t* data, size_t len){
+  const uint8_t tag = 0x00;
+  sha256 ctx(data, len);
+  ctx.update(&tag, 1);
+  return ctx.finalize();
+}
+
+Digest sha256_tree(const uint8_t* data, size_t len, size_t leaf_size, unsigned threads){
+  if(leaf_size == 0) throw std::invalid_argument("A levélméret nem lehet 0!");
+  size_t nleaves = (len == 0) ? 1 : (len + leaf_size - 1) / leaf_size;
+  if(threads == 0) threads = std::thread::hardware_concurrency();
+  if(threads == 0) threads = 1;
+  if(threads > nleaves) threads = (unsigned)nleaves;
+
+  /**
+   * Levelek: a szálak egy közös számlálóból veszik a következő feldolgozandó levél indexét.
+   */
+  Vector<Digest> level = Vector<Digest>::for_overwrite(nleaves);
+  Digest* out = level.data();
+  std::atomic<size_t> next(0);
+  auto worker = [&](){
+    for(size_t i = next++; i < nleaves; i = next++){
+      size_t off = i*leaf_size;
+      size_t n = (len - off < leaf_size) ? len - off : leaf_size;
+      out[i] = leaf_hash(data + off, n);
+    }
+  };
+  if(len == 0) out[0] = leaf_hash(data, 0);
+  else if(threads == 1) worker();
+  else{
+    std::unique_ptr<std::thread[]> pool(new std::thread[threads - 1]);
+    for(unsigned t = 0; t < threads - 1; ++t){
+      pool[t] = std::thread(worker);
+    }
+    worker();
+    for(unsigned t = 0; t < threads - 1; ++t){
+      pool[t].join();
+    }
+  }
+
+  /**
+   * Belső csúcsok: egy szint összes párját egyszerre, kötegelten hasheljük (sha256_many).
+   */
+  while(level.size() > 1){
+    size_t pairs = level.size() / 2;
+    bool odd = level.size() % 2 == 1;
+    Vector<uint8_t> buf = Vector<uint8_t>::for_overwrite(pairs*65);
+    Vector<sha256_message> msgs(pairs);
+    for(size_t i = 0; i < pairs; ++i){
+      uint8_t* p = buf.data() + i*65;
+      memcpy(p, level[2*i].data(), Digest::size);
+      memcpy(p + Digest::size, level[2*i+1].data(), Digest::size);
+      p[64] = 0x01;
+      msgs[i].data = p;
+      msgs[i].len = 65;
+    }
+    Vector<Digest> parent = Vector<Digest>::for_overwrite(pairs + (odd ? 1 : 0));
+    sha256_many(msgs.data(), pairs, parent.data());
+    if(odd) parent[pairs] = level[level.size() - 1];
+    level = std::move(parent);
+  }
+  return level[0];
+}
+
+Digest sha256_tree_file(const char* path, size_t leaf_size, unsigned threads){
+  MappedFile file(path);
+  file.hint_willneed();
+  return sha256_tree(file.data(), file.size(), leaf_size, threads);
+}
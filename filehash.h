@@ -0,0 +1,45 @@
+#ifndef FILEHASH
+#define FILEHASH
+#include <cstddef>
+#include <cstdint>
+#include "digest.h"
+/**
+ * @file filehash.h
+ * Fájlok és nagy memóriaterületek hashelésének header fájlja.
+ * A fájlokat mmap-pel olvassuk, így a tartalom másolás nélkül jut el a tömörítő függvényig.
+ */
+
+/**
+ * Egy fájl hagyományos, szekvenciális SHA256 hash-e.
+ * Bitre megegyezik azzal, mintha a fájl teljes tartalmát egy sha256 objektummal hashelnénk.
+ * Ha a fájl nem olvasható, std::runtime_error-t dob.
+ * @param path a fájl elérési útja.
+ * @return Digest.
+ */
+Digest sha256_file(const char* path);
+/**
+ * Fa (Merkle) hash egy memóriaterületre.
+ * Az adatot leaf_size méretű levelekre bontja (az utolsó rövidebb lehet), a leveleket párhuzamosan, threads szálon hasheli,
+ * majd szintenként páronként összevonja őket:
+ *  - levél:  SHA256(levél || 0x00)
+ *  - belső:  SHA256(bal || jobb || 0x01)
+ *  - ha egy szinten páratlan sok csúcs van, az utolsó változatlanul lép a következő szintre.
+ * A jelölő byte a végére kerül, hogy a levelek blokkhatárra igazítva, másolás nélkül kerüljenek a kernelhez.
+ * Az eredmény NEM egyezik meg a szekvenciális hash-sel, viszont független a szálak számától.
+ * @param data az adat kezdőcíme.
+ * @param len az adat hossza byte-ban.
+ * @param leaf_size a levelek mérete byte-ban, nem lehet 0.
+ * @param threads a használt szálak száma, 0 esetén a processzormagok száma.
+ * @return Digest.
+ */
+Digest sha256_tree(const uint8_t* data, size_t len, size_t leaf_size = 1 << 20, unsigned threads = 0);
+/**
+ * Egy fájl fa (Merkle) hash-e, lásd sha256_tree.
+ * Ha a fájl nem olvasható, std::runtime_error-t dob.
+ * @param path a fájl elérési útja.
+ * @param leaf_size a levelek mérete byte-ban, nem lehet 0.
+ * @param threads a használt szálak száma, 0 esetén a processzormagok száma.
+ * @return Digest.
+ */
+Digest sha256_tree_file(const char* path, size_t leaf_size = 1 << 20, unsigned threads = 0);
+#endif
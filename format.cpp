@@ -0,0 +1,124 @@
+#include "format.h"
+#include "cpu.h"
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(CPU_X86)
+#include <immintrin.h>
+#endif
+
+static const char hex_digits[] = "0123456789abcdef";
+/**
+ * 00..99 két karakteres alakjai egymás után, így egy osztással két számjegy áll elő.
+ */
+static const char digit_pairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+size_t format_int(char* out, int value){
+  char tmp[int_max_digits];
+  char* p = tmp + sizeof(tmp);
+  /**
+   * Előjel nélküli abszolút értékkel számolunk, így INT_MIN is helyes.
+   */
+  uint32_t u = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  while(u >= 100){
+    uint32_t r = u % 100;
+    u /= 100;
+    p -= 2;
+    memcpy(p, digit_pairs + 2*r, 2);
+  }
+  if(u >= 10){
+    p -= 2;
+    memcpy(p, digit_pairs + 2*u, 2);
+  }
+  else{
+    *--p = (char)('0' + u);
+  }
+  if(value < 0) *--p = '-';
+  size_t len = (size_t)(tmp + sizeof(tmp) - p);
+  memcpy(out, p, len);
+  return len;
+}
+void format_hex32(char* out, uint32_t value){
+  for(int i = 7; i >= 0; --i){
+    out[i] = hex_digits[value & 0x0f];
+    value >>= 4;
+  }
+}
+#if defined(CPU_X86)
+/**
+ * 32 byte-os blokkok: a felső és alsó nibble-ket pshufb-vel alakítjuk karakterré a 16 elemű táblából,
+ * majd byte-onként összefésüljük őket. A maradékot (n % 32) nem érinti.
+ */
+__attribute__((target("avx2")))
+static void to_hex_avx2(const uint8_t* src, size_t n, char* out){
+  const __m256i table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  for(size_t i = 0; i + 32 <= n; i += 32){
+    __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low_mask));
+    /**
+     * Az unpack 128 bites sávokon belül fésül, ezért a sávokat a tárolás előtt sorba rakjuk.
+     */
+    __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256((__m256i*)(out + 2*i), _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256((__m256i*)(out + 2*i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+  }
+}
+#endif
+#if defined(__SSE2__)
+/**
+ * 16 byte-os blokkok pshufb nélkül: nibble + '0', és 9 fölött még 'a' - '0' - 10. A maradékot (n % 16) nem érinti.
+ */
+static void to_hex_sse2(const uint8_t* src, size_t n, char* out){
+  const __m128i low_mask = _mm_set1_epi8(0x0f);
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i letter = _mm_set1_epi8('a' - '0' - 10);
+  for(size_t i = 0; i + 16 <= n; i += 16){
+    __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+    __m128i lo = _mm_and_si128(v, low_mask);
+    hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letter));
+    lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letter));
+    _mm_storeu_si128((__m128i*)(out + 2*i), _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128((__m128i*)(out + 2*i + 16), _mm_unpackhi_epi8(hi, lo));
+  }
+}
+#endif
+void to_hex(const uint8_t* src, size_t n, char* out){
+  size_t done = 0;
+#if defined(CPU_X86)
+  static bool has_avx2 = cpu_has_avx2();
+  if(has_avx2 && n >= 32){
+    to_hex_avx2(src, n, out);
+    done = n & ~(size_t)31;
+  }
+#endif
+#if defined(__SSE2__)
+  to_hex_sse2(src + done, n - done, out + 2*done);
+  done += (n - done) & ~(size_t)15;
+#endif
+  for(size_t i = done; i < n; ++i){
+    out[2*i] = hex_digits[src[i] >> 4];
+    out[2*i+1] = hex_digits[src[i] & 0x0f];
+  }
+}
+String to_hex(const uint8_t* src, size_t n){
+  StringBuilder res;
+  to_hex(src, n, res.append_uninitialized(2*n));
+  return res.str();
+}
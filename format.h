@@ -0,0 +1,44 @@
+#ifndef FORMAT
+#define FORMAT
+#include <cstddef>
+#include <cstdint>
+#include "string.h"
+/**
+ * @file format.h
+ * Szám formázó függvények header fájlja: decimális egész, 32 bites hexadecimális szó és tetszőleges hosszú byte sorozat hexadecimális alakja.
+ * A függvények táblázatból, közvetlenül a cél bufferbe írnak, nem hívnak sem libm-et, sem printf-et.
+ */
+
+/**
+ * Egy int decimális alakjának legnagyobb hossza, előjellel, lezáró karakter nélkül.
+ */
+const size_t int_max_digits = 11;
+/**
+ * Decimális alakra hozza a számot (negatív számnál '-' előjellel), lezáró '\0' nélkül.
+ * @param out legalább int_max_digits byte-os buffer.
+ * @param value a szám.
+ * @return size_t a kiírt karakterek száma.
+ */
+size_t format_int(char* out, int value);
+/**
+ * 8 kisbetűs hexadecimális számjegyre hozza a szót (mint a "%08x"), lezáró '\0' nélkül.
+ * @param out legalább 8 byte-os buffer.
+ * @param value a szó.
+ */
+void format_hex32(char* out, uint32_t value);
+/**
+ * A byte-ok kisbetűs hexadecimális alakja, byte-onként két karakter, lezáró '\0' nélkül.
+ * Nagy bufferekre AVX2-vel (32 byte-onként, pshufb nibble táblával) vagy SSE2-vel (16 byte-onként) dolgozik.
+ * @param src a byte-ok.
+ * @param n a byte-ok száma.
+ * @param out legalább 2*n byte-os buffer.
+ */
+void to_hex(const uint8_t* src, size_t n, char* out);
+/**
+ * A byte-ok kisbetűs hexadecimális alakja Stringként.
+ * @param src a byte-ok.
+ * @param n a byte-ok száma.
+ * @return String.
+ */
+String to_hex(const uint8_t* src, size_t n);
+#endif
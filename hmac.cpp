@@ -0,0 +1,133 @@
+#include "hmac.h"
+#include "sha256_kernel.h"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * A láncolt állapot szavait big endian byte sorrendben kiírja.
+ */
+static void store_be(uint8_t* p, const uint32_t w[8]){
+  for(size_t i = 0; i < 8; ++i){
+    p[4*i] = (uint8_t)(w[i] >> 24);
+    p[4*i+1] = (uint8_t)(w[i] >> 16);
+    p[4*i+2] = (uint8_t)(w[i] >> 8);
+    p[4*i+3] = (uint8_t)w[i];
+  }
+}
+/**
+ * Előkészít egy blokkot 32 byte-os üzenethez, amit egy 64 byte-os kulcs blokk előz meg:
+ * az első 32 byte az üzenet helye, utána 0x80, nullák, és a (64+32)*8 = 768 bites hossz.
+ */
+static void pad32(uint8_t block[64]){
+  memset(block + 32, 0, 32);
+  block[32] = 0x80;
+  block[62] = 0x03;
+  block[63] = 0x00;
+}
+/**
+ * Egy HMAC 32 byte-os üzenetre, két tömörítéssel: u = H(opad || H(ipad || u)).
+ * A block előre ki kell legyen töltve a pad32 függvénnyel.
+ */
+static void hmac32(const uint32_t istate[8], const uint32_t ostate[8], uint8_t block[64], uint32_t u[8]){
+  uint32_t s[8];
+  store_be(block, u);
+  memcpy(s, istate, sizeof(s));
+  sha256_compress(s, block, 1);
+  store_be(block, s);
+  memcpy(u, ostate, sizeof(s));
+  sha256_compress(u, block, 1);
+}
+
+void hmac_sha256::init(const uint8_t* key, size_t len){
+  uint8_t k[64];
+  memset(k, 0, sizeof(k));
+  if(len > 64){
+    Digest d = sha256(key, len).finalize();
+    memcpy(k, d.data(), Digest::size);
+  }
+  else if(len > 0){
+    memcpy(k, key, len);
+  }
+  uint8_t pad[64];
+  for(size_t i = 0; i < 64; ++i) pad[i] = k[i] ^ 0x36;
+  inner_pad.update(pad, 64);
+  for(size_t i = 0; i < 64; ++i) pad[i] = k[i] ^ 0x5c;
+  outer_pad.update(pad, 64);
+  memcpy(istate, inner_pad.h, sizeof(istate));
+  memcpy(ostate, outer_pad.h, sizeof(ostate));
+  inner = inner_pad;
+}
+hmac_sha256::hmac_sha256(const uint8_t* key, size_t len){
+  init(key, len);
+}
+hmac_sha256::hmac_sha256(const String& key){
+  init((const uint8_t*)key.c_string(), key.getLength());
+}
+void hmac_sha256::update(const uint8_t* data, size_t len){
+  inner.update(data, len);
+}
+void hmac_sha256::update(const String& _arg){
+  inner.update(_arg);
+}
+Digest hmac_sha256::finalize(){
+  Digest ih = inner.finalize();
+  inner = inner_pad;
+  sha256 outer = outer_pad;
+  outer.update(ih.data(), Digest::size);
+  return outer.finalize();
+}
+Digest hmac_sha256::mac32(const Digest& msg) const{
+  uint8_t block[64];
+  pad32(block);
+  uint32_t u[8];
+  const uint8_t* m = msg.data();
+  for(size_t i = 0; i < 8; ++i){
+    u[i] = ((uint32_t)m[4*i] << 24) | ((uint32_t)m[4*i+1] << 16) | ((uint32_t)m[4*i+2] << 8) | (uint32_t)m[4*i+3];
+  }
+  hmac32(istate, ostate, block, u);
+  Digest res;
+  store_be(res.data(), u);
+  return res;
+}
+
+void pbkdf2_sha256(const uint8_t* password, size_t pwlen, const uint8_t* salt, size_t saltlen, uint32_t iterations, uint8_t* out, size_t outlen){
+  if(iterations == 0) throw std::invalid_argument("A PBKDF2 iterációk száma nem lehet 0!");
+  hmac_sha256 prf(password, pwlen);
+  uint8_t block[64];
+  pad32(block);
+  for(uint32_t i = 1; outlen > 0; ++i){
+    /**
+     * U_1 = HMAC(jelszó, só || INT(i)), ez az egyetlen változó hosszú üzenet.
+     */
+    uint8_t idx[4] = {(uint8_t)(i >> 24), (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i};
+    prf.update(salt, saltlen);
+    prf.update(idx, 4);
+    Digest u1 = prf.finalize();
+    uint32_t u[8], t[8];
+    const uint8_t* m = u1.data();
+    for(size_t j = 0; j < 8; ++j){
+      u[j] = ((uint32_t)m[4*j] << 24) | ((uint32_t)m[4*j+1] << 16) | ((uint32_t)m[4*j+2] << 8) | (uint32_t)m[4*j+3];
+      t[j] = u[j];
+    }
+    /**
+     * U_j = HMAC(jelszó, U_{j-1}), mindegyik két tömörítés a midstate-ekből.
+     */
+    for(uint32_t c = 1; c < iterations; ++c){
+      hmac32(prf.istate, prf.ostate, block, u);
+      for(size_t j = 0; j < 8; ++j){
+        t[j] ^= u[j];
+      }
+    }
+    uint8_t tb[32];
+    store_be(tb, t);
+    size_t n = outlen < 32 ? outlen : 32;
+    memcpy(out, tb, n);
+    out += n;
+    outlen -= n;
+  }
+}
+Vector<uint8_t> pbkdf2_sha256(const String& password, const String& salt, uint32_t iterations, size_t outlen){
+  Vector<uint8_t> res = Vector<uint8_t>::for_overwrite(outlen);
+  pbkdf2_sha256((const uint8_t*)password.c_string(), password.getLength(), (const uint8_t*)salt.c_string(), salt.getLength(), iterations, res.data(), outlen);
+  return res;
+}
@@ -0,0 +1,86 @@
+#ifndef HMAC
+#define HMAC
+#include <cstddef>
+#include <cstdint>
+#include "string.h"
+#include "vector.hpp"
+#include "digest.h"
+#include "sha256.h"
+/**
+ * @file hmac.h
+ * A HMAC-SHA256 osztály és a PBKDF2-HMAC-SHA256 kulcsszármaztató függvény header fájlja.
+ */
+
+/**
+ * HMAC-SHA256 (RFC 2104).
+ * A konstruktor egyszer tömöríti a (kulcs ^ ipad) és (kulcs ^ opad) blokkokat, és eltárolja a kapott midstate-eket.
+ * Minden további MAC számítás ezekből indul, így a kulcs blokkot soha nem kell újra feldolgozni.
+ */
+class hmac_sha256{
+  sha256 inner_pad; /**< a (kulcs ^ ipad) blokk feldolgozása utáni kontextus.*/
+  sha256 outer_pad; /**< a (kulcs ^ opad) blokk feldolgozása utáni kontextus.*/
+  sha256 inner; /**< a folyamatban lévő belső hash, inner_pad-ból indul.*/
+  uint32_t istate[8]; /**< az inner_pad láncolt állapota, a 32 byte-os gyors úthoz.*/
+  uint32_t ostate[8]; /**< az outer_pad láncolt állapota, a 32 byte-os gyors úthoz.*/
+  void init(const uint8_t* key, size_t len);
+  public:
+  /**
+   * Konstruktor.
+   * A 64 byte-nál hosszabb kulcsot előbb lehasheli, ahogy a szabvány előírja.
+   * @param key a kulcs kezdőcíme.
+   * @param len a kulcs hossza byte-ban.
+   */
+  hmac_sha256(const uint8_t* key, size_t len);
+  /**
+   * Konstruktor.
+   * @param key a kulcs.
+   */
+  explicit hmac_sha256(const String& key);
+  /**
+   * Hozzáadja az üzenet következő darabját.
+   * @param data a byte-ok kezdőcíme.
+   * @param len a byte-ok száma.
+   */
+  void update(const uint8_t* data, size_t len);
+  /**
+   * Hozzáfűz egy Stringet az üzenethez.
+   * @param a hozzáfűzendő String.
+   */
+  void update(const String&);
+  /**
+   * Lezárja az üzenetet és visszaadja a MAC-et.
+   * Utána a belső állapot visszaáll a kulcs midstate-jére, tehát ugyanazzal a kulccsal újrahasználható.
+   * @return Digest.
+   */
+  Digest finalize();
+  /**
+   * Gyors út pontosan 32 byte-os üzenetre (pl. PBKDF2 iteráció): pontosan két tömörítő függvény hívás.
+   * @param msg az üzenet.
+   * @return Digest.
+   */
+  Digest mac32(const Digest& msg) const;
+  friend void pbkdf2_sha256(const uint8_t*, size_t, const uint8_t*, size_t, uint32_t, uint8_t*, size_t);
+};
+/**
+ * PBKDF2-HMAC-SHA256 kulcsszármaztatás (RFC 8018).
+ * A HMAC midstate-eket egyszer számolja ki, iterációnként pedig csak két tömörítést végez.
+ * Ha iterations 0, std::invalid_argument-et dob.
+ * @param password a jelszó kezdőcíme.
+ * @param pwlen a jelszó hossza.
+ * @param salt a só kezdőcíme.
+ * @param saltlen a só hossza.
+ * @param iterations az iterációk száma.
+ * @param out a kimeneti buffer.
+ * @param outlen a kért kulcs hossza byte-ban.
+ */
+void pbkdf2_sha256(const uint8_t* password, size_t pwlen, const uint8_t* salt, size_t saltlen, uint32_t iterations, uint8_t* out, size_t outlen);
+/**
+ * PBKDF2-HMAC-SHA256 kulcsszármaztatás Stringekre.
+ * @param password a jelszó.
+ * @param salt a só.
+ * @param iterations az iterációk száma.
+ * @param outlen a kért kulcs hossza byte-ban.
+ * @return Vector<uint8_t>.
+ */
+Vector<uint8_t> pbkdf2_sha256(const String& password, const String& salt, uint32_t iterations, size_t outlen = 32);
+#endif
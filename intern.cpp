@@ -0,0 +1,132 @@
+#include "intern.h"
+#include <cstring>
+
+/**
+ * Egy aréna blokk mérete; az ennek negyedénél nagyobb szövegek saját blokkot kapnak.
+ */
+static const size_t chunk_default = 64 * 1024;
+
+uint64_t string_hash(const StringView& str){
+  const uint64_t m = 0x9e3779b97f4a7c15ULL;
+  const char* p = str.data();
+  size_t n = str.getLength();
+  uint64_t h = 0xcbf29ce484222325ULL ^ ((uint64_t)n * m);
+  while(n >= 8){
+    uint64_t w;
+    memcpy(&w, p, 8);
+    h = (h ^ w) * m;
+    h ^= h >> 32;
+    p += 8;
+    n -= 8;
+  }
+  if(n > 0){
+    uint64_t w = 0;
+    memcpy(&w, p, n);
+    h = (h ^ w) * m;
+    h ^= h >> 32;
+  }
+  /**
+   * Végső keverés (a MurmurHash3 fmix64 lépése), hogy az alsó bitek, amikkel a táblát indexeljük, minden bemeneti bittől függjenek.
+   */
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+InternPool::InternPool(size_t expected): count(0), chunk(NULL), chunk_used(0), chunk_size(0), bytes(0){
+  size_t size = 16;
+  while(size < 2*expected) size *= 2;
+  slots = new const InternNode*[size];
+  for(size_t i = 0; i < size; ++i) slots[i] = NULL;
+  mask = size - 1;
+}
+void* InternPool::allocate(size_t size){
+  size = (size + 7) & ~(size_t)7;
+  if(size > chunk_default / 4){
+    /**
+     * Nagy szöveg: saját blokk, amit az aktuális blokk mögé fűzünk a listába, így az aktuális blokk maradéka megmarad.
+     */
+    char* block = new char[sizeof(char*) + size];
+    bytes += sizeof(char*) + size;
+    if(chunk != NULL){
+      char* next;
+      memcpy(&next, chunk, sizeof(char*));
+      memcpy(block, &next, sizeof(char*));
+      memcpy(chunk, &block, sizeof(char*));
+    }
+    else{
+      char* none = NULL;
+      memcpy(block, &none, sizeof(char*));
+      chunk = block;
+      chunk_used = chunk_size = sizeof(char*) + size;
+    }
+    return block + sizeof(char*);
+  }
+  if(chunk == NULL || chunk_used + size > chunk_size){
+    char* block = new char[chunk_default];
+    bytes += chunk_default;
+    memcpy(block, &chunk, sizeof(char*));
+    chunk = block;
+    chunk_used = sizeof(char*);
+    chunk_size = chunk_default;
+  }
+  void* p = chunk + chunk_used;
+  chunk_used += size;
+  return p;
+}
+void InternPool::rehash(){
+  size_t size = 2*(mask + 1);
+  const InternNode** tmp = new const InternNode*[size];
+  for(size_t i = 0; i < size; ++i) tmp[i] = NULL;
+  for(size_t i = 0; i <= mask; ++i){
+    if(slots[i] == NULL) continue;
+    size_t j = slots[i]->hash & (size - 1);
+    while(tmp[j] != NULL) j = (j + 1) & (size - 1);
+    tmp[j] = slots[i];
+  }
+  delete[] slots;
+  slots = tmp;
+  mask = size - 1;
+}
+Interned InternPool::find(const StringView& str) const{
+  uint64_t h = string_hash(str);
+  for(size_t i = h & mask; slots[i] != NULL; i = (i + 1) & mask){
+    const InternNode* node = slots[i];
+    if(node->hash == h && node->len == str.getLength() && memcmp(node->text(), str.data(), node->len) == 0){
+      return Interned(node);
+    }
+  }
+  return Interned();
+}
+Interned InternPool::intern(const StringView& str){
+  if(2*(count + 1) > mask + 1) rehash();
+  uint64_t h = string_hash(str);
+  size_t i = h & mask;
+  for(; slots[i] != NULL; i = (i + 1) & mask){
+    const InternNode* node = slots[i];
+    if(node->hash == h && node->len == str.getLength() && memcmp(node->text(), str.data(), node->len) == 0){
+      return Interned(node);
+    }
+  }
+  InternNode* node = (InternNode*)allocate(sizeof(InternNode) + str.getLength() + 1);
+  node->hash = h;
+  node->len = str.getLength();
+  char* text = (char*)(node + 1);
+  memcpy(text, str.data(), node->len);
+  text[node->len] = '\0';
+  slots[i] = node;
+  ++count;
+  return Interned(node);
+}
+InternPool::~InternPool(){
+  while(chunk != NULL){
+    char* next;
+    memcpy(&next, chunk, sizeof(char*));
+    delete[] chunk;
+    chunk = next;
+  }
+  delete[] slots;
+}
@@ -0,0 +1,172 @@
+#ifndef INTERN
+#define INTERN
+#include <cstddef>
+#include <cstdint>
+#include "stringview.h"
+/**
+ * @file intern.h
+ * Az InternPool (szöveg internáló tábla) és az Interned (internált szöveg azonosító) osztályok header fájlja.
+ */
+
+/**
+ * 64 bites hash egy byte sorozatra.
+ * 8 byte-onként szorzással és eltolással kever, a végén teljes lavinahatással. Nem kriptográfiai hash.
+ * @param str a szöveg.
+ * @return uint64_t.
+ */
+uint64_t string_hash(const StringView& str);
+
+/**
+ * Egy internált szöveg a poolban: a hash, a hossz és közvetlenül utánuk a karakterek ('\0'-val lezárva).
+ */
+struct InternNode{
+  uint64_t hash; /**< a szöveg előre kiszámolt hash-e.*/
+  size_t len; /**< a szöveg hossza.*/
+  /**
+   * A node után közvetlenül tárolt karakterek.
+   */
+  const char* text() const{
+    return (const char*)(this + 1);
+  }
+};
+
+/**
+ * Egy internált szöveg azonosítója (handle).
+ * Egyetlen pointer méretű, másolása ingyenes. Két, ugyanabból a poolból származó azonosító pontosan akkor egyenlő,
+ * ha a szövegük egyenlő, így az összehasonlítás egy pointer összehasonlítás. A hash-t nem kell újraszámolni.
+ * Az azonosító a pool élettartamáig érvényes.
+ */
+class Interned{
+  const InternNode* node; /**< a szöveg a poolban, üres azonosítónál NULL.*/
+  public:
+  /**
+   * Paraméter nélküli konstruktor, üres (semmire sem mutató) azonosító.
+   */
+  Interned(): node(NULL){}
+  /**
+   * Konstruktor, az InternPool használja.
+   * @param node a szöveg a poolban.
+   */
+  explicit Interned(const InternNode* node): node(node){}
+  /**
+   * Igaz, ha az azonosító nem mutat szövegre.
+   * @return bool.
+   */
+  bool empty() const{
+    return node == NULL;
+  }
+  /**
+   * Visszaadja a szöveg előre kiszámolt hash-ét (üres azonosítónál 0).
+   * @return uint64_t.
+   */
+  uint64_t hash() const{
+    return node ? node->hash : 0;
+  }
+  /**
+   * Visszaadja a szöveg hosszát.
+   * @return size_t.
+   */
+  size_t getLength() const{
+    return node ? node->len : 0;
+  }
+  /**
+   * Visszaadja a '\0'-val lezárt szöveget.
+   * @return const char*.
+   */
+  const char* c_string() const{
+    return node ? node->text() : "";
+  }
+  /**
+   * Nézet a szövegre.
+   * @return StringView.
+   */
+  StringView view() const{
+    return StringView(c_string(), getLength());
+  }
+  /**
+   * Nézet a szövegre, hogy az azonosító átadható legyen StringView paraméternek.
+   */
+  operator StringView() const{
+    return view();
+  }
+  /**
+   * Összehasonlító operátor: pointer összehasonlítás.
+   * @param rhs a másik azonosító, ugyanabból a poolból.
+   * @return bool.
+   */
+  bool operator==(const Interned& rhs) const{
+    return node == rhs.node;
+  }
+  /**
+   * Negált összehasonlító operátor.
+   * @param rhs a másik azonosító, ugyanabból a poolból.
+   * @return bool.
+   */
+  bool operator!=(const Interned& rhs) const{
+    return node != rhs.node;
+  }
+};
+
+/**
+ * Szöveg internáló tábla.
+ * Minden különböző szöveget egyszer tárol, nagy blokkokban (arénában) foglalva, így soronként nincs külön foglalás és malloc fejléc.
+ * A keresés nyílt címzésű hash táblában történik; a tárolt hash-t hasonlítjuk először, és csak egyezés esetén a byte-okat.
+ * A tábla nem szálbiztos, és nem másolható. Elemet törölni nem lehet, a szövegek a pool destruktoráig élnek.
+ */
+class InternPool{
+  const InternNode** slots; /**< a hash tábla, kettő hatvány méretű, az üres hely NULL.*/
+  size_t mask; /**< a tábla mérete - 1.*/
+  size_t count; /**< az internált szövegek száma.*/
+  char* chunk; /**< az aktuális aréna blokk; minden blokk elején a megelőző blokkra mutató pointer áll.*/
+  size_t chunk_used; /**< az aktuális blokk foglalt byte-jai.*/
+  size_t chunk_size; /**< az aktuális blokk mérete.*/
+  size_t bytes; /**< a szövegekre foglalt összes byte (blokkok és nagy szövegek).*/
+  InternPool(const InternPool&);
+  InternPool& operator=(const InternPool&);
+  /**
+   * Helyet foglal egy size byte-os node-nak az arénában (8 byte-ra igazítva).
+   */
+  void* allocate(size_t size);
+  /**
+   * Megduplázza a hash tábla méretét, és újraosztja a meglévő elemeket a tárolt hash-ek alapján.
+   */
+  void rehash();
+  public:
+  /**
+   * Konstruktor.
+   * @param expected a várható különböző szövegek száma, ennyihez előre méretezi a táblát.
+   */
+  explicit InternPool(size_t expected = 0);
+  /**
+   * Visszaadja a szöveg azonosítóját, és ha még nincs a poolban, eltárolja.
+   * @param str a szöveg.
+   * @return Interned.
+   */
+  Interned intern(const StringView& str);
+  /**
+   * Megkeresi a szöveget, de nem tárolja el.
+   * @param str a szöveg.
+   * @return Interned a szöveg azonosítója, vagy üres azonosító, ha nincs a poolban.
+   */
+  Interned find(const StringView& str) const;
+  /**
+   * Visszaadja a különböző internált szövegek számát.
+   * @return size_t.
+   */
+  size_t size() const{
+    return count;
+  }
+  /**
+   * Visszaadja a szövegekre foglalt memória méretét byte-ban (a hash táblát nem számítva).
+   * @return size_t.
+   */
+  size_t memory() const{
+    return bytes;
+  }
+  /**
+   * Destruktor.
+   * Felszabadítja a táblát és az összes szöveget; az azonosítók ezután érvénytelenek.
+   */
+  ~InternPool();
+};
+#endif
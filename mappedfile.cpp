@@ -0,0 +1,38 @@
+#include "mappedfile.h"
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const char* path): ptr(NULL), len(0){
+  int fd = open(path, O_RDONLY);
+  if(fd < 0) throw std::runtime_error("A fájlt nem sikerült megnyitni!");
+  struct stat st;
+  if(fstat(fd, &st) != 0){
+    close(fd);
+    throw std::runtime_error("A fájl méretét nem sikerült lekérdezni!");
+  }
+  len = (size_t)st.st_size;
+  if(len > 0){
+    void* p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(p == MAP_FAILED){
+      close(fd);
+      throw std::runtime_error("A fájlt nem sikerült a memóriába leképezni!");
+    }
+    ptr = (const uint8_t*)p;
+  }
+  /**
+   * A leképezés a fájlleíró lezárása után is érvényes marad.
+   */
+  close(fd);
+}
+void MappedFile::hint_sequential() const{
+  if(len > 0) madvise((void*)ptr, len, MADV_SEQUENTIAL);
+}
+void MappedFile::hint_willneed() const{
+  if(len > 0) madvise((void*)ptr, len, MADV_WILLNEED);
+}
+MappedFile::~MappedFile(){
+  if(len > 0) munmap((void*)ptr, len);
+}
@@ -0,0 +1,55 @@
+#ifndef MAPPEDFILE
+#define MAPPEDFILE
+#include <cstddef>
+#include <cstdint>
+/**
+ * @file mappedfile.h
+ * A MappedFile osztály header fájlja.
+ */
+
+/**
+ * Csak olvasható, memóriába leképezett (mmap) fájl.
+ * A fájl tartalmát másolás nélkül, közvetlenül a page cache-ből teszi elérhetővé.
+ * A leképezés a destruktorig él, ezért az objektum nem másolható.
+ */
+class MappedFile{
+  const uint8_t* ptr; /**< a leképezett terület kezdőcíme, üres fájlnál NULL.*/
+  size_t len; /**< a fájl mérete byte-ban.*/
+  MappedFile(const MappedFile&);
+  MappedFile& operator=(const MappedFile&);
+  public:
+  /**
+   * Konstruktor.
+   * Megnyitja és leképezi a fájlt. Ha ez nem sikerül, std::runtime_error-t dob.
+   * @param path a fájl elérési útja.
+   */
+  explicit MappedFile(const char* path);
+  /**
+   * Visszadja a fájl tartalmának kezdőcímét.
+   * @return const uint8_t*.
+   */
+  const uint8_t* data() const{
+    return ptr;
+  }
+  /**
+   * Visszadja a fájl méretét.
+   * @return size_t.
+   */
+  size_t size() const{
+    return len;
+  }
+  /**
+   * Jelzi a kernelnek, hogy a fájlt az elejétől a végéig, sorban fogjuk olvasni (agresszívabb előreolvasás).
+   */
+  void hint_sequential() const;
+  /**
+   * Jelzi a kernelnek, hogy a fájl egészére hamarosan szükség lesz (pl. több szál párhuzamosan olvassa).
+   */
+  void hint_willneed() const;
+  /**
+   * Destruktor.
+   * Megszünteti a leképezést.
+   */
+  ~MappedFile();
+};
+#endif
@@ -0,0 +1,57 @@
+#ifndef MAPPEDTEXT
+#define MAPPEDTEXT
+#include <cstddef>
+#include "mappedfile.h"
+#include "stringview.h"
+/**
+ * @file mappedtext.h
+ * A MappedText osztály header fájlja.
+ */
+
+/**
+ * Csak olvasható, memóriába leképezett szöveg fájl.
+ * A fájl tartalmát StringView-ként adja át, így bárhol használható, ahol egy szöveget csak olvasunk
+ * (Cipher::encode, sha256, StringSplit), anélkül hogy a tartalmat egy Stringbe másolnánk.
+ * A leképezésre szekvenciális olvasást jelez a kernelnek, így a nagy fájlok előreolvasása agresszívabb,
+ * és a már elolvasott lapok a page cache-ből bármikor eldobhatók. A nézetek a MappedText élettartamáig érvényesek.
+ */
+class MappedText{
+  MappedFile file; /**< a leképezett fájl.*/
+  public:
+  /**
+   * Konstruktor.
+   * Megnyitja és leképezi a fájlt. Ha ez nem sikerül, std::runtime_error-t dob.
+   * @param path a fájl elérési útja.
+   */
+  explicit MappedText(const char* path): file(path){
+    file.hint_sequential();
+  }
+  /**
+   * Visszaadja a szöveg kezdőcímét (nem '\0'-val lezárt).
+   * @return const char*.
+   */
+  const char* data() const{
+    return file.size() > 0 ? (const char*)file.data() : "";
+  }
+  /**
+   * Visszaadja a szöveg hosszát.
+   * @return size_t.
+   */
+  size_t getLength() const{
+    return file.size();
+  }
+  /**
+   * Nézet a teljes szövegre.
+   * @return StringView.
+   */
+  StringView view() const{
+    return StringView(data(), getLength());
+  }
+  /**
+   * Nézet a teljes szövegre, hogy a MappedText közvetlenül átadható legyen StringView paraméternek.
+   */
+  operator StringView() const{
+    return view();
+  }
+};
+#endif
@@ -1,17 +1,41 @@
 #include "cipher.h"
 #include "vector.hpp"
+#include "smallvector.hpp"
 #include "string.h"
 #include "list.hpp"
 #include "sha256.h"
+#include "sha256_kernel.h"
 #include "account.h"
+#include "filehash.h"
+#include "hmac.h"
+#include "ascii.h"
+#include "format.h"
+#include "mappedtext.h"
+#include "intern.h"
 #include <iostream>
 #include "gtest_lite.h"
 #include <stdexcept>
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
 
 using std::cout;
 using std::cin;
 using std::endl;
 
+/**
+ * Élő példányokat számoló típus a Vector tesztekhez.
+ */
+struct Szamlalo{
+  static int elo; /**< az élő példányok száma.*/
+  int ertek;
+  Szamlalo(int ertek = -1): ertek(ertek){ ++elo; }
+  Szamlalo(const Szamlalo& other): ertek(other.ertek){ ++elo; }
+  Szamlalo& operator=(const Szamlalo& other){ ertek = other.ertek; return *this; }
+  ~Szamlalo(){ --elo; }
+};
+int Szamlalo::elo = 0;
+
 int main(void){
 /**
  *  1. A paraméter nélkül hívható konstruktora üres sztringet hozzon étre!
@@ -134,6 +158,143 @@ int main(void){
 
     } ENDM
 
+/**
+ *  6. Mozgatás: a hosszú String buffere másolás nélkül költözik, a rövid a példányban marad.
+ */
+    TEST(String6, move) {
+      const char *hosszu = "Ez egy hosszu, heapen tarolt sztring";
+      String a(hosszu);
+      const char *p = a.c_string();
+      String b(std::move(a));
+      EXPECT_EQ(p, b.c_string()) << "A mozgato konstruktor lemasolta a buffert!" << endl;
+      EXPECT_STREQ(hosszu, b.c_string());
+      EXPECT_EQ((size_t)0, a.getLength());
+      EXPECT_STREQ("", a.c_string());
+      String c("rovid");
+      c = std::move(b);
+      EXPECT_EQ(p, c.c_string()) << "A mozgato ertekadas lemasolta a buffert!" << endl;
+      EXPECT_STREQ("", b.c_string());
+      String d("1234567890123456789012");
+      String e("12345678901234567890123");
+      String f(std::move(d));
+      String g(std::move(e));
+      EXPECT_STREQ("1234567890123456789012", f.c_string());
+      EXPECT_STREQ("12345678901234567890123", g.c_string());
+      f = g;
+      EXPECT_STREQ("12345678901234567890123", f.c_string());
+      g = String("x");
+      EXPECT_STREQ("x", g.c_string());
+    } ENDM
+
+/**
+ *  6. Hozzáfűzés: kapacitás, reserve és StringBuilder.
+ */
+    TEST(String6, append) {
+      String a;
+      a.reserve(100);
+      EXPECT_EQ(true, a.getCapacity() >= 100);
+      const char *p = a.c_string();
+      for(int i = 0; i < 100; ++i) a += 'x';
+      EXPECT_EQ((size_t)100, a.getLength());
+      EXPECT_EQ(p, a.c_string()) << "A reserve utan nem kellett volna ujrafoglalni!" << endl;
+      a.clear();
+      a += "rovid";
+      EXPECT_EQ(p, a.c_string()) << "A clear utan a dinamikus buffer maradjon!" << endl;
+      EXPECT_EQ((size_t)5, a.getLength());
+      EXPECT_EQ(true, a.getCapacity() >= 100);
+      EXPECT_EQ((size_t)String::sso_capacity, String("rovid").getCapacity());
+      String b("abc");
+      b += b;
+      b += "def";
+      b += String("gh");
+      EXPECT_STREQ("abcabcdefgh", b.c_string());
+      for(int i = 0; i < 4; ++i) b += b;
+      EXPECT_EQ((size_t)176, b.getLength());
+      EXPECT_STREQ("abcabcdefgh", b.c_string() + 165);
+
+      StringBuilder sb;
+      for(int i = 0; i < 1000; ++i) sb.append((char)('a' + i % 26));
+      sb.append("XY", 2).append(String("Z"));
+      EXPECT_EQ((size_t)1003, sb.getLength());
+      String c = sb.str();
+      EXPECT_EQ((size_t)1003, c.getLength());
+      EXPECT_STREQ("xyzabcdefghijklXYZ", c.c_string() + 985);
+      EXPECT_EQ((size_t)0, sb.getLength());
+      EXPECT_STREQ("", sb.str().c_string());
+    } ENDM
+
+/**
+ *  6. Bináris tartalom: a beágyazott '\0' byte-ok nem vágják el a Stringet.
+ */
+    TEST(String6, binary) {
+      String a("ab\0cd", 5);
+      EXPECT_EQ((size_t)5, a.getLength());
+      String b = a;
+      EXPECT_EQ((size_t)5, b.getLength());
+      EXPECT_EQ(true, a & b);
+      EXPECT_EQ(false, a & String("ab"));
+      EXPECT_EQ(true, a == 'd');
+      String c = a + a;
+      EXPECT_EQ((size_t)10, c.getLength());
+      EXPECT_EQ(0, memcmp("ab\0cdab\0cd", c.c_string(), 10));
+      std::stringstream ss;
+      ss << a;
+      EXPECT_EQ((size_t)5, ss.str().size());
+    } ENDM
+
+/**
+ *  6. Megosztott (STRING_COW) és saját bufferes módban is: a másolat módosítása nem hat az eredetire.
+ */
+    TEST(String6, cow) {
+      const char *kulcs = "egy-hosszu-kozos-kulcs-amit-sok-objektum-masol";
+      String a(kulcs);
+      String b = a;
+      String c;
+      c = a;
+#if defined(STRING_COW)
+      EXPECT_EQ(a.c_string(), b.c_string()) << "COW modban a masolat megosztja a buffert!" << endl;
+      EXPECT_EQ(a.c_string(), c.c_string());
+#endif
+      b[0] = 'E';
+      c.toUpper();
+      String d = a;
+      d += "!";
+      String e = a;
+      e.clear();
+      EXPECT_STREQ(kulcs, a.c_string());
+      EXPECT_EQ('E', b[0]);
+      EXPECT_STREQ("gy-hosszu-kozos-kulcs-amit-sok-objektum-masol", b.c_string() + 1);
+      EXPECT_STREQ("EGY-HOSSZU-KOZOS-KULCS-AMIT-SOK-OBJEKTUM-MASOL", c.c_string());
+      EXPECT_EQ(a.getLength() + 1, d.getLength());
+      EXPECT_STREQ("", e.c_string());
+      b = a;
+      b = String("rovid");
+      EXPECT_STREQ(kulcs, a.c_string());
+    } ENDM
+/**
+ *  6. A StringBuilder másolata sem ír a megosztott bufferbe (STRING_COW módban).
+ */
+    TEST(String6, cow_builder) {
+      const char *alap = "0123456789012345678901234567890123456789";
+      StringBuilder a(64);
+      a.append(alap, 40);
+      StringBuilder b = a;
+      StringBuilder c = a;
+      StringBuilder d = a;
+      b.append('X');
+      a.append('Y');
+      c.append("ab", 2);
+      *d.append_uninitialized(1) = 'Z';
+      StringBuilder e = a;
+      String es = e.str();
+      a.append('W');
+      EXPECT_STREQ("0123456789012345678901234567890123456789X", b.str().c_string());
+      EXPECT_STREQ("0123456789012345678901234567890123456789ab", c.str().c_string());
+      EXPECT_STREQ("0123456789012345678901234567890123456789Z", d.str().c_string());
+      EXPECT_STREQ("0123456789012345678901234567890123456789Y", es.c_string());
+      EXPECT_STREQ("0123456789012345678901234567890123456789YW", a.str().c_string());
+    } ENDM
+
 /**
  *  7. Legyenek olyan operátorai (operator+), amivel a sztring végéhez sztringet
  *     és karaktert/intet lehet fűzni!
@@ -183,20 +344,70 @@ int main(void){
 
     } ENDM
 
+    TEST(String7, format) {
+      EXPECT_STREQ("0", String(0).c_string());
+      EXPECT_STREQ("7", String(7).c_string());
+      EXPECT_STREQ("-42", String(-42).c_string());
+      EXPECT_STREQ("2147483647", String(2147483647).c_string());
+      EXPECT_STREQ("-2147483648", String(-2147483647 - 1).c_string());
+      EXPECT_EQ((size_t)11, String(-2147483647 - 1).getLength());
+      EXPECT_STREQ("deadbeef", String((uint32_t)0xdeadbeef).c_string());
+      EXPECT_STREQ("0000000a", String((uint32_t)10).c_string());
+
+      /// Az SIMD blokkok és a skalár maradék minden hossznál ugyanazt adják, mint a byte-onkénti alak.
+      uint8_t bytes[100];
+      for(size_t i = 0; i < sizeof(bytes); ++i) bytes[i] = (uint8_t)(i * 37 + 5);
+      bool ok = true;
+      for(size_t n = 0; n <= sizeof(bytes); ++n){
+        String h = to_hex(bytes, n);
+        ok = ok && h.getLength() == 2*n;
+        for(size_t i = 0; i < n && ok; ++i){
+          char elvart[3];
+          snprintf(elvart, sizeof(elvart), "%02x", bytes[i]);
+          ok = h[2*i] == elvart[0] && h[2*i+1] == elvart[1];
+        }
+      }
+      EXPECT_EQ(true, ok);
+    } ENDM
+
 /**
- * 8. Müködjön a substr(), isalpha(), toUpper() és toLower() tagfüggvények,
+ * 8. Müködjön a split(), isalpha(), toUpper() és toLower() tagfüggvények,
  */
-    TEST(String8, subStr) {
+    TEST(String8, split) {
       String a("Hello szia viszlát");
       String b, c, d;
-      b = a.substr(' ');
-      c = a.substr(' ');
-      d = a.substr(' ');
-      EXPECT_STREQ("Hello", b.c_string()) << "Nem sikerult a substr művelet" << endl;
-      EXPECT_STREQ("szia", c.c_string()) << "Nem sikerult a substr művelet" << endl;
-      EXPECT_STREQ("viszlát", d.c_string()) << "Nem sikerult a substr művelet" << endl;
-    } ENDM
+      StringSplit::iterator it = a.split(' ').begin();
+      b = String(*it++);
+      c = String(*it++);
+      d = String(*it++);
+      EXPECT_STREQ("Hello", b.c_string()) << "Nem sikerult a split művelet" << endl;
+      EXPECT_STREQ("szia", c.c_string()) << "Nem sikerult a split művelet" << endl;
+      EXPECT_STREQ("viszlát", d.c_string()) << "Nem sikerult a split művelet" << endl;
+      EXPECT_EQ(true, it == a.split(' ').end());
 
+      /// A darabok az eredeti bufferre mutatnak, a többszörös szeparátor és a sorvége is elválaszt.
+      String sorok("  felhasznalo1;hash1;so1\nfelhasznalo2;;hash2;egy-joval-hosszabb-so-ertek\n\n");
+      const char *elvart[] = {"  felhasznalo1", "hash1", "so1", "felhasznalo2", "hash2", "egy-joval-hosszabb-so-ertek"};
+      size_t n = 0;
+      for(StringView tok : sorok.split(';')){
+        EXPECT_EQ(true, n < 6);
+        if(n < 6) EXPECT_EQ(true, tok == StringView(elvart[n]));
+        EXPECT_EQ(true, tok.data() >= sorok.c_string() && tok.end() <= sorok.c_string() + sorok.getLength());
+        ++n;
+      }
+      EXPECT_EQ((size_t)6, n);
+      n = 0;
+      String csak_szeparator("\n;;\n");
+      for(StringView tok : csak_szeparator.split(';')){
+        (void)tok;
+        ++n;
+      }
+      EXPECT_EQ((size_t)0, n);
+      StringView v(sorok);
+      EXPECT_EQ((size_t)14, v.find(';'));
+      EXPECT_EQ(StringView::npos, v.find('#'));
+      EXPECT_EQ(true, v.sub(2, 12) == StringView("felhasznalo1"));
+    } ENDM
     TEST(String8, isalpha) {
       String a("Hello szia viszlát");
       EXPECT_EQ(false, a.isalpha());
@@ -218,6 +429,40 @@ int main(void){
       EXPECT_STREQ("heloka", a.c_string()) << "Nem sikerult a toLower művelet" << endl;
     } ENDM
 
+    TEST(String8, ascii) {
+      /// Minden byte érték, a SIMD blokkok és a skalár maradék minden pozícióján.
+      char buf[300], up[300], low[300];
+      for(size_t i = 0; i < sizeof(buf); ++i) buf[i] = (char)(i * 7);
+      memcpy(up, buf, sizeof(buf));
+      memcpy(low, buf, sizeof(buf));
+      ascii_toupper(up, sizeof(up));
+      ascii_tolower(low, sizeof(low));
+      bool ok = true;
+      for(size_t i = 0; i < sizeof(buf); ++i){
+        unsigned char c = (unsigned char)buf[i];
+        bool betu = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        ok = ok && (unsigned char)up[i] == ((c >= 'a' && c <= 'z') ? c - 32 : c);
+        ok = ok && (unsigned char)low[i] == ((c >= 'A' && c <= 'Z') ? c + 32 : c);
+        ok = ok && ascii_isalpha(buf + i, 1) == betu;
+      }
+      EXPECT_EQ(true, ok);
+
+      String hosszu("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklm");
+      EXPECT_EQ(true, hosszu.isalpha());
+      for(size_t i = 0; i < hosszu.getLength(); ++i){
+        String rossz = hosszu;
+        rossz[i] = (i % 2) ? '@' : '[';
+        EXPECT_EQ(false, rossz.isalpha());
+        EXPECT_EQ(false, rossz.toUpperAlpha());
+      }
+      char cel[66];
+      EXPECT_EQ(true, ascii_upper_alpha(hosszu.c_string(), hosszu.getLength(), cel));
+      cel[65] = '\0';
+      EXPECT_STREQ("ABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLMNOPQRSTUVWXYZABCDEFGHIJKLM", cel);
+      EXPECT_EQ(true, hosszu.toUpperAlpha());
+      EXPECT_STREQ(cel, hosszu.c_string());
+    } ENDM
+
 /**
  *  9. A tárolt a karakterek legyenek elérhetőek a szokásos módon indexeléssel!
  *     Az indexeléssel elért elem legyen használható balértékként is!
@@ -263,6 +508,35 @@ int main(void){
       EXPECT_STREQ("sztring", in2.c_string());
       EXPECT_STREQ("Lajos12", in3.c_string());
     } ENDM
+
+    TEST(String11, getline) {
+      std::stringstream ss;
+      String hosszu;
+      for(int i = 0; i < 100; ++i) hosszu += "0123456789";
+      ss << hosszu << "\nrovid sor\n\nutolso";
+      String sor;
+      EXPECT_EQ(true, (bool)getline(ss, sor));
+      EXPECT_EQ(true, sor & hosszu);
+      const char *buf = sor.c_string();
+      EXPECT_EQ(true, (bool)getline(ss, sor));
+      EXPECT_STREQ("rovid sor", sor.c_string());
+      EXPECT_EQ(buf, sor.c_string()) << "A sor buffere nem lett ujrahasznalva!" << endl;
+      EXPECT_EQ(true, (bool)getline(ss, sor));
+      EXPECT_STREQ("", sor.c_string());
+      EXPECT_EQ(true, (bool)getline(ss, sor));
+      EXPECT_STREQ("utolso", sor.c_string());
+      EXPECT_EQ(false, (bool)getline(ss, sor));
+
+      std::stringstream ss2;
+      ss2 << "  " << hosszu << "\t szo";
+      String szo;
+      ss2 >> szo;
+      EXPECT_EQ(true, szo & hosszu);
+      ss2 >> szo;
+      EXPECT_STREQ("szo", szo.c_string());
+      EXPECT_EQ(false, (bool)(ss2 >> szo));
+      EXPECT_STREQ("szo", szo.c_string());
+    } ENDM
 /**
  * 12. Teszteli hogy működik-e a String kompralálás és a needle in the haystack művelet.
  */
@@ -308,15 +582,17 @@ int main(void){
     } ENDM
 /**
  * 3. Indexelő operátorok tesztelése.
- * Hibakezelés tesztelése.
+ * Hibakezelés tesztelése: az at() ellenőriz, az operator[] nem.
  */
     TEST(Vector3, index) {
       Vector<int> a(9);
-      EXPECT_NO_THROW(a[0]);
-      EXPECT_NO_THROW(a[7]);
-      EXPECT_NO_THROW(a[8]);
-      EXPECT_THROW(a[9], std::out_of_range const&);
-      EXPECT_THROW(a[-1],std::out_of_range const&);
+      EXPECT_NO_THROW(a.at(0));
+      EXPECT_NO_THROW(a.at(7));
+      EXPECT_NO_THROW(a.at(8));
+      EXPECT_THROW(a.at(9), std::out_of_range const&);
+      EXPECT_THROW(a.at(-1),std::out_of_range const&);
+      a[8] = 5;
+      EXPECT_EQ(5, a.at(8));
     } ENDM
 /**
  * 4. Push_back operátor tesztelése.
@@ -328,12 +604,231 @@ int main(void){
       EXPECT_EQ(3,a[0]);
       EXPECT_EQ((size_t)10,a.sizet());
     } ENDM
+/**
+ * 5. Geometriai nyújtás, mozgatás, emplace_back, reserve és shrink_to_fit tesztelése.
+ */
+    TEST(Vector5, move) {
+      Vector<int> a;
+      for(int i = 0; i < 11; ++i) a.push_back(i);
+      EXPECT_EQ((size_t)20, a.sizet());
+      for(int i = 11; i < 1280; ++i) a.push_back(i);
+      EXPECT_EQ((size_t)1280, a.sizet());
+      EXPECT_EQ(999, a[999]);
+      a.push_back(a[0]);
+      EXPECT_EQ((size_t)2560, a.sizet());
+      EXPECT_EQ(0, a[1280]);
+
+      Vector<int> b(std::move(a));
+      EXPECT_EQ((size_t)1281, b.size());
+      EXPECT_EQ((size_t)0, a.size());
+      a.push_back(7);
+      EXPECT_EQ(7, a[0]);
+      a = std::move(b);
+      EXPECT_EQ((size_t)1281, a.size());
+      EXPECT_EQ(500, a[500]);
+      EXPECT_EQ((size_t)0, b.size());
+
+      a.shrink_to_fit();
+      EXPECT_EQ((size_t)1281, a.sizet());
+      EXPECT_EQ(1000, a[1000]);
+      a.reserve(5000);
+      EXPECT_EQ((size_t)5000, a.sizet());
+      a.reserve(10);
+      EXPECT_EQ((size_t)5000, a.sizet());
+      EXPECT_EQ(1000, a[1000]);
+
+      Vector<String> s;
+      s.emplace_back("hosszabb mint huszonket karakter");
+      s.emplace_back("abc", (size_t)2);
+      String& r = s.emplace_back('x');
+      EXPECT_STREQ("x", r.c_string());
+      EXPECT_STREQ("ab", s[1].c_string());
+      for(int i = 3; i < 10; ++i) s.push_back(String(i));
+      s.push_back(s[0]);
+      EXPECT_EQ((size_t)20, s.sizet());
+      EXPECT_STREQ("hosszabb mint huszonket karakter", s[10].c_string());
+      EXPECT_STREQ("hosszabb mint huszonket karakter", s[0].c_string());
+    } ENDM
+/**
+ * 6. Nyers tárolás: csak a méreten belüli helyeken él objektum, resize és for_overwrite tesztelése.
+ */
+    TEST(Vector6, storage) {
+      {
+        Vector<Szamlalo> a(3);
+        EXPECT_EQ(3, Szamlalo::elo);
+        for(int i = 0; i < 8; ++i) a.push_back(Szamlalo(i));
+        EXPECT_EQ((size_t)20, a.sizet());
+        EXPECT_EQ(11, Szamlalo::elo);
+        EXPECT_EQ(7, a[10].ertek);
+        Vector<Szamlalo> b = a;
+        EXPECT_EQ(22, Szamlalo::elo);
+        b.resize(2);
+        EXPECT_EQ(13, Szamlalo::elo);
+        b.resize(5);
+        EXPECT_EQ(16, Szamlalo::elo);
+        a = b;
+        EXPECT_EQ(10, Szamlalo::elo);
+        a.reserve(100);
+        a.shrink_to_fit();
+        EXPECT_EQ(10, Szamlalo::elo);
+      }
+      EXPECT_EQ(0, Szamlalo::elo);
+
+      Vector<int> n;
+      n.resize(4);
+      EXPECT_EQ(0, n[3]);
+      Vector<uint8_t> u = Vector<uint8_t>::for_overwrite(1000);
+      EXPECT_EQ((size_t)1000, u.size());
+      u[999] = 7;
+      u.resize_uninitialized(10);
+      EXPECT_EQ((size_t)10, u.size());
+      u.resize_uninitialized(2000);
+      EXPECT_EQ((size_t)2000, u.sizet());
+      u.resize_uninitialized(2001);
+      EXPECT_EQ((size_t)4000, u.sizet());
+
+      /// Ismételt kis növelés: a kapacitás duplázódik, nem lépésenként nő.
+      Vector<int> r;
+      for(int i = 0; i < 10; ++i) r.resize(r.size() + 3);
+      EXPECT_EQ((size_t)30, r.size());
+      EXPECT_EQ((size_t)48, r.sizet());
+      EXPECT_EQ(0, r[29]);
+    } ENDM
+/**
+ * 7. data(), Span és közvetlen hozzáférésű iterátorok tesztelése.
+ */
+    TEST(Vector7, iterator) {
+      Vector<int> a;
+      for(int i = 0; i < 100; ++i) a.push_back((i * 37) % 100);
+      std::sort(a.begin(), a.end());
+      EXPECT_EQ(0, a[0]);
+      EXPECT_EQ(99, a[99]);
+      EXPECT_EQ(100, (int)(a.end() - a.begin()));
+      EXPECT_EQ(42, *std::lower_bound(a.begin(), a.end(), 42));
+      Vector<int>::iterator it = a.begin() + 10;
+      EXPECT_EQ(10, *it);
+      EXPECT_EQ(12, it[2]);
+      EXPECT_EQ(9, *--it);
+      EXPECT_EQ(true, a.begin() < it && it <= a.end());
+      EXPECT_EQ(10, *(a.begin() + 10));
+      EXPECT_EQ(0, *a.begin());
+
+      const Vector<int>& c = a;
+      Vector<int>::const_iterator cit = a.begin();
+      EXPECT_EQ(true, cit == c.begin());
+      EXPECT_EQ(99, *(c.end() - 1));
+      EXPECT_EQ(a.data(), c.data());
+
+      Span<const int> s = c;
+      EXPECT_EQ((size_t)100, s.size());
+      EXPECT_EQ(50, s[50]);
+      EXPECT_EQ(98, s.sub(97).at(1));
+      EXPECT_EQ((size_t)3, s.sub(97, 10).size());
+      EXPECT_THROW(s.at(100), std::out_of_range const&);
+      Span<int> m = a.span();
+      for(int& x : m) x *= 2;
+      EXPECT_EQ(198, a[99]);
+      Vector<int> ures;
+      EXPECT_EQ(true, ures.span().empty());
+      EXPECT_EQ(true, ures.begin() == ures.end());
+    } ENDM
+/**
+ * 8. SmallVector: N elemig a belső tárolóban, fölötte dinamikusan.
+ */
+    TEST(Vector8, small) {
+      {
+        SmallVector<Szamlalo, 4> a;
+        for(int i = 0; i < 4; ++i) a.emplace_back(i);
+        EXPECT_EQ(true, a.is_small());
+        EXPECT_EQ((size_t)4, a.sizet());
+        EXPECT_EQ(4, Szamlalo::elo);
+        a.push_back(a[0]);
+        EXPECT_EQ(false, a.is_small());
+        EXPECT_EQ((size_t)10, a.sizet());
+        EXPECT_EQ(0, a[4].ertek);
+        EXPECT_EQ(5, Szamlalo::elo);
+
+        SmallVector<Szamlalo, 4> b(std::move(a));
+        EXPECT_EQ(false, b.is_small());
+        EXPECT_EQ((size_t)0, a.size());
+        EXPECT_EQ(true, a.is_small());
+        b.resize(3);
+        b.shrink_to_fit();
+        EXPECT_EQ(true, b.is_small());
+        EXPECT_EQ(2, b.at(2).ertek);
+        EXPECT_EQ(3, Szamlalo::elo);
+
+        SmallVector<Szamlalo, 4> c = b;
+        a = std::move(c);
+        EXPECT_EQ((size_t)3, a.size());
+        EXPECT_EQ(1, a[1].ertek);
+        EXPECT_EQ(6, Szamlalo::elo);
+        EXPECT_THROW(a.at(3), std::out_of_range const&);
+      }
+      EXPECT_EQ(0, Szamlalo::elo);
+
+      SmallVector<int, 8> s;
+      for(int i = 20; i > 0; --i) s.push_back(i);
+      std::sort(s.begin(), s.end());
+      EXPECT_EQ(1, s[0]);
+      EXPECT_EQ(20, *(s.end() - 1));
+      SmallVector<int, 8> t = s;
+      EXPECT_EQ(true, t == s);
+      Vector<int> w;
+      for(int i = 1; i <= 20; ++i) w.push_back(i);
+      EXPECT_EQ(true, w == t);
+      EXPECT_EQ(true, (std::is_nothrow_move_constructible<SmallVector<int, 8> >::value));
+      Span<const int> v = t;
+      EXPECT_EQ((size_t)20, v.size());
+      SmallVector<uint8_t, 16> u = SmallVector<uint8_t, 16>::for_overwrite(10);
+      EXPECT_EQ(true, u.is_small());
+      u.resize(40);
+      EXPECT_EQ(0, u[39]);
+    } ENDM
+/**
+ * 9. Igazított tárolás: a memória az Align szabály szerinti határon kezdődik, nyújtás és másolás után is.
+ */
+    TEST(Vector9, align) {
+      Vector<double, Align<32>> a;
+      for(int i = 0; i < 100; ++i){
+        a.push_back(i);
+        if((uintptr_t)a.data() % 32 != 0) FAIL() << "nem igazitott" << endl;
+      }
+      EXPECT_EQ((size_t)32, (Vector<double, Align<32>>::alignment));
+      Vector<double, Align<32>> b = a;
+      EXPECT_EQ((uintptr_t)0, (uintptr_t)b.data() % 32);
+      b.shrink_to_fit();
+      EXPECT_EQ((uintptr_t)0, (uintptr_t)b.data() % 32);
+      EXPECT_EQ(true, b == a);
+      Vector<double> c;
+      for(int i = 0; i < 100; ++i) c.push_back(i);
+      EXPECT_EQ(true, a == c);
+      EXPECT_EQ((size_t)alignof(double), Vector<double>::alignment);
+
+      XOR x("kulcs");
+      Vigenere v("KULCS");
+      Bifid f("KULCS");
+      Ciphertext cx = x.encode("Titkos uzenet");
+      Ciphertext cv = v.encode("TitkosUzenet");
+      Ciphertext cf = f.encode("TitkosUzenet");
+      EXPECT_EQ((uintptr_t)0, (uintptr_t)cx.data() % 64);
+      EXPECT_EQ((uintptr_t)0, (uintptr_t)cv.data() % 64);
+      EXPECT_EQ((uintptr_t)0, (uintptr_t)cf.data() % 64);
+      Vector<uint8_t> regi(x.encode("Titkos uzenet"));
+      EXPECT_EQ(true, regi == cx);
+      EXPECT_EQ(false, (std::is_convertible<Ciphertext, Vector<uint8_t> >::value));
+      EXPECT_STREQ("Titkos uzenet", x.decode(cx).c_string());
+      Vector<uint8_t> sima;
+      for(size_t i = 0; i < cx.size(); ++i) sima.push_back(cx[i]);
+      EXPECT_STREQ("Titkos uzenet", x.decode(sima).c_string());
+      EXPECT_EQ(true, sha256(cx).digest() == sha256(sima).digest());
+    } ENDM
 /**
  * 1. Titkosítások tesztelése
  */
     TEST(Cipher1,XOR ) {
      XOR mode0("almafa12");
-     Vector<uint8_t> ciphertext0 = mode0.encode("Nagy titok");
+     Ciphertext ciphertext0 = mode0.encode("Nagy titok");
      /* Manuális leteszteljük a titkosítás eredményét*/
      uint8_t tmp[] = {0x2f, 0x0d, 0x0a, 0x18, 0x46, 0x15, 0x58, 0x46, 0x0e, 0x07};
      Vector<uint8_t> elvart0;
@@ -346,12 +841,20 @@ int main(void){
 
 
      Cipher* test = new XOR("almafa12");
-     Vector<uint8_t> ciphertext1 = test->encode("Nagy titok");
+     Ciphertext ciphertext1 = test->encode("Nagy titok");
      /* Manuális leteszteljük a titkosítás eredményét*/
      EXPECT_EQ(true, ciphertext1 == elvart0);
      String plaintext1 = test->decode(ciphertext1);
      EXPECT_STREQ("Nagy titok", plaintext1.c_string());
      delete test;
+
+     /* Bináris szöveg, beágyazott 0 byte-tal, és a kulccsal egyező byte-ok is oda-vissza alakíthatók*/
+     String binaris("al\0ma\xff", 6);
+     String vissza = mode0.decode(mode0.encode(binaris));
+     EXPECT_EQ((size_t)6, vissza.getLength());
+     EXPECT_EQ(true, vissza & binaris);
+
+     EXPECT_THROW(XOR ures(""), std::invalid_argument const&); //üres kulccsal nem lehet titkosítani
     } ENDM
 
     TEST(Cipher1,Vigenere ) {
@@ -361,7 +864,7 @@ int main(void){
      for(size_t i = 0; i < 12; ++i){
       elvart0.push_back(tmp[i]);
      }
-   Vector<uint8_t> ciphertext1 = mode1.encode("nagyobbtitok");
+   Ciphertext ciphertext1 = mode1.encode("nagyobbtitok");
      EXPECT_EQ(true, ciphertext1 == elvart0);
      String plaintext1 = mode1.decode(ciphertext1);
      EXPECT_STREQ("NAGYOBBTITOK", plaintext1.c_string());
@@ -369,7 +872,7 @@ int main(void){
      EXPECT_THROW(mode1.encode("ilyátsemszabad98"), std::invalid_argument const&); //csak angol abc-beli karakterekből lehet titkoítandót csinálni
 
      Cipher* test = new Vigenere("kulcs");
-     Vector<uint8_t> ciphertext0 = test->encode("nagyobbtitok");
+     Ciphertext ciphertext0 = test->encode("nagyobbtitok");
      EXPECT_EQ(true, ciphertext0 == elvart0);
      String plaintext0 = test->decode(ciphertext0);
      EXPECT_STREQ("NAGYOBBTITOK", plaintext0.c_string());
@@ -378,7 +881,7 @@ int main(void){
 
     TEST(Cipher1,Bifid ) {
      Bifid mode2("biztonsagos");
-     Vector<uint8_t> ciphertext2 = mode2.encode("legnagyobbtitok");
+     Ciphertext ciphertext2 = mode2.encode("legnagyobbtitok");
      Vector<uint8_t> elvart0;
      String tmp("PSSUBBBDGZRUTGY");
      for(size_t i = 0; i < 15; ++i){
@@ -391,7 +894,7 @@ int main(void){
      EXPECT_THROW(mode2.encode("ilyátsemszabad98"), std::invalid_argument const&); //csak angol abc-beli karakterekből lehet titkoítandót csinálni
 
      Cipher *test = new Bifid("biztonsagos");
-     Vector<uint8_t> ciphertext1 = test->encode("legnagyobbtitok");
+     Ciphertext ciphertext1 = test->encode("legnagyobbtitok");
      EXPECT_EQ(true, ciphertext1 == elvart0);
      String plaintext0 = test->decode(ciphertext1);
      EXPECT_STREQ("LEGNAGYOBBTITOK", plaintext0.c_string());
@@ -410,13 +913,332 @@ int main(void){
      b.update("só");
      EXPECT_STREQ("c6906131b8e6fc1502eebab767b805cace4df0d56ff017bbd057c76bba2940f6", b.hexdigest().c_string());
     } ENDM
+/**
+ * 2. Streamelő kontextus tesztelése.
+ * Darabokban átadott input ugyanazt a hash-t kell adja, mint egyben.
+ */
+    TEST(Sha256, stream ) {
+     const char *szoveg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+     sha256 a;
+     for(size_t i = 0; i < strlen(szoveg); i += 5){
+      size_t n = strlen(szoveg) - i < 5 ? strlen(szoveg) - i : 5;
+      a.update((const uint8_t*)szoveg + i, n);
+     }
+     EXPECT_STREQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", a.hexdigest().c_string());
+     EXPECT_STREQ(sha256(szoveg).hexdigest().c_string(), a.hexdigest().c_string());
+     sha256 ures;
+     Digest out = ures.finalize();
+     EXPECT_EQ(0xe3, out[0]);
+     EXPECT_EQ(0x55, out[31]);
+    } ENDM
+/**
+ * 3. A kernelek tesztelése.
+ * A futásidőben kiválasztott kernel ugyanazt az állapotot kell adja, mint a hordozható skalár kernel.
+ */
+    TEST(Sha256, kernel ) {
+     uint8_t blocks[3*64];
+     for(size_t i = 0; i < sizeof(blocks); ++i) blocks[i] = (uint8_t)(i*7 + 3);
+     uint32_t s0[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+     uint32_t s1[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+     sha256_compress_scalar(s0, blocks, 3);
+     sha256_compress(s1, blocks, 3);
+     for(size_t i = 0; i < 8; ++i){
+      EXPECT_EQ(s0[i], s1[i]) << "Elter a(z) " << sha256_kernel_name() << " kernel" << endl;
+     }
+    } ENDM
+/**
+ * 4. Kötegelt hashelés tesztelése.
+ * 11 üzenet: 8 a sha256_many által választott úton (AVX2 lane-eken, ha SHA-NI nincs), 3 a maradékban, különböző blokkszámokkal.
+ * Az AVX2 utat SHA-NI-s processzoron a következő teszt futtatja.
+ */
+    TEST(Sha256, many ) {
+     const char *szovegek[11] = {"", "a", "abc", "Valentin", "almafa12", "jelszó", "só",
+       "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+       "hasheljük ezt mert miért ne, hasheljük ezt mert miért ne, hasheljük ezt",
+       "x", "0123456789012345678901234567890123456789012345678901234"};
+     sha256_message msgs[11];
+     for(size_t i = 0; i < 11; ++i){
+      msgs[i].data = (const uint8_t*)szovegek[i];
+      msgs[i].len = strlen(szovegek[i]);
+     }
+     Digest digests[11];
+     sha256_many(msgs, 11, digests);
+     for(size_t i = 0; i < 11; ++i){
+      EXPECT_EQ(true, sha256(szovegek[i]).digest() == digests[i]) << "Elter a(z) " << i << ". uzenet hash-e" << endl;
+     }
+    } ENDM
+/**
+ * 5. A 8 lane-es AVX2 kernel tesztelése, a sha256_many választásától függetlenül.
+ * Lane-enként eltérő számú blokk megy át a kernelen, és minden lane-nek a skalár kernellel kapott állapotot kell adnia.
+ * AVX2 nélküli processzoron kimarad.
+ */
+    TEST(Sha256, x8 ) {
+#if defined(SHA256_HAVE_AVX2)
+     if(cpu_has_avx2()){
+      uint8_t data[8][3*64];
+      uint32_t state[8][8], expected[8][8];
+      for(size_t lane = 0; lane < 8; ++lane){
+       for(size_t i = 0; i < sizeof(data[lane]); ++i) data[lane][i] = (uint8_t)(i*7 + lane*31 + 3);
+       for(size_t i = 0; i < 8; ++i){
+        state[i][lane] = (uint32_t)(lane*8 + i + 1);
+        expected[lane][i] = state[i][lane];
+       }
+       sha256_compress_scalar(expected[lane], data[lane], lane % 3 + 1);
+      }
+      for(size_t b = 0; b < 3; ++b){
+       const uint8_t* blocks[8];
+       uint32_t saved[8][8];
+       for(size_t lane = 0; lane < 8; ++lane){
+        blocks[lane] = data[lane] + (b < lane % 3 + 1 ? b : 0)*64;
+        for(size_t i = 0; i < 8; ++i) saved[i][lane] = state[i][lane];
+       }
+       sha256_compress_x8_avx2(state, blocks);
+       for(size_t lane = 0; lane < 8; ++lane){
+        if(b >= lane % 3 + 1){
+         for(size_t i = 0; i < 8; ++i) state[i][lane] = saved[i][lane];
+        }
+       }
+      }
+      for(size_t lane = 0; lane < 8; ++lane){
+       for(size_t i = 0; i < 8; ++i){
+        EXPECT_EQ(expected[lane][i], state[i][lane]) << "Elter a(z) " << lane << ". lane" << endl;
+       }
+      }
+
+      const size_t hosszak[8] = {0, 3, 55, 56, 64, 119, 200, 1000};
+      uint8_t uzenet[1000];
+      for(size_t i = 0; i < sizeof(uzenet); ++i) uzenet[i] = (uint8_t)(i*13 + 5);
+      sha256_message msgs[8];
+      for(size_t lane = 0; lane < 8; ++lane){
+       msgs[lane].data = uzenet + lane;
+       msgs[lane].len = hosszak[lane] - (hosszak[lane] > 8 ? lane : 0);
+      }
+      Digest digests[8];
+      sha256_many_x8(msgs, digests);
+      sha256_compress_fn selected = sha256_compress;
+      sha256_compress = sha256_compress_scalar;
+      for(size_t lane = 0; lane < 8; ++lane){
+       EXPECT_EQ(true, sha256(msgs[lane].data, msgs[lane].len).finalize() == digests[lane]) << "Elter a(z) " << lane << ". uzenet hash-e" << endl;
+      }
+      sha256_compress = selected;
+     }
+#endif
+    } ENDM
+/**
+ * 6. Bináris input tesztelése.
+ * '\0' byte-ot tartalmazó titkosított szöveg is hashelhető, és ugyanazt adja mint a nyers byte-ok.
+ */
+    TEST(Sha256, binary ) {
+     XOR mode("aaaa");
+     Ciphertext ciphertext = mode.encode("bab");
+     EXPECT_EQ(0, ciphertext[1]);
+     uint8_t nyers[3] = {0x03, 0x00, 0x03};
+     EXPECT_EQ(true, sha256(ciphertext).digest() == sha256(nyers, 3).digest());
+     EXPECT_EQ(false, sha256(ciphertext).digest() == sha256(nyers, 1).digest());
+     Vector<uint8_t> ures;
+     EXPECT_STREQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", sha256(ures).hexdigest().c_string());
+    } ENDM
+/**
+ * 5. A bináris hash típus tesztelése.
+ * Hexadecimális oda-vissza alakítás, összehasonlítás, hibás input kezelése.
+ */
+    TEST(Digest, hex ) {
+     Digest a = sha256("abc").digest();
+     EXPECT_STREQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", a.hex().c_string());
+     Digest b = Digest::fromHex("BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD");
+     EXPECT_EQ(true, a == b);
+     EXPECT_EQ(false, a != b);
+     EXPECT_EQ(false, a == Digest());
+     EXPECT_THROW(Digest::fromHex("ba78"), std::invalid_argument const&);
+     EXPECT_THROW(Digest::fromHex("xa7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), std::invalid_argument const&);
+    } ENDM
+/**
+ * 7. Fájl és fa hash tesztelése.
+ * A szekvenciális fájl hash bitre egyezik az sha256 osztályéval, a fa hash pedig független a szálak számától.
+ */
+    TEST(Sha256, file ) {
+     const char *fajlnev = "filehash_teszt.bin";
+     Vector<uint8_t> tartalom(300000);
+     for(size_t i = 0; i < tartalom.size(); ++i) tartalom[i] = (uint8_t)(i*31 + i/7);
+     FILE *f = fopen(fajlnev, "wb");
+     fwrite(&tartalom[0], 1, tartalom.size(), f);
+     fclose(f);
+     EXPECT_EQ(true, sha256_file(fajlnev) == sha256(tartalom).digest());
+     Digest fa1 = sha256_tree_file(fajlnev, 4096, 1);
+     EXPECT_EQ(true, fa1 == sha256_tree_file(fajlnev, 4096, 4));
+     EXPECT_EQ(true, fa1 == sha256_tree(&tartalom[0], tartalom.size(), 4096, 3));
+     EXPECT_EQ(false, fa1 == sha256_tree(&tartalom[0], tartalom.size(), 8192, 3));
+     uint8_t level[4] = {'a', 'b', 'c', 0x00};
+     EXPECT_EQ(true, sha256_tree(level, 3, 64, 2) == sha256(level, 4).digest());
+     remove(fajlnev);
+     EXPECT_THROW(sha256_file(fajlnev), std::runtime_error const&);
+    } ENDM
+/**
+ * MappedText: a leképezett fájl másolás nélkül titkosítható, hashelhető és darabolható.
+ */
+    TEST(Cipher1, MappedText ) {
+     const char *fajlnev = "mappedtext_teszt.txt";
+     String szoveg;
+     for(int i = 0; i < 2000; ++i) szoveg += "NagyTitok;masodik\n";
+     FILE *f = fopen(fajlnev, "wb");
+     fwrite(szoveg.c_string(), 1, szoveg.getLength(), f);
+     fclose(f);
+     {
+       MappedText text(fajlnev);
+       EXPECT_EQ(szoveg.getLength(), text.getLength());
+       XOR mode0("almafa12");
+       EXPECT_EQ(true, mode0.encode(text) == mode0.encode(szoveg));
+       EXPECT_EQ(true, sha256(text).digest() == sha256(szoveg).digest());
+       size_t n = 0;
+       for(StringView tok : StringSplit(text, ';')){
+         n += tok.getLength();
+       }
+       EXPECT_EQ((size_t)2000 * 16, n);
+       Vigenere mode1("kulcs");
+       EXPECT_THROW(mode1.encode(text), std::invalid_argument const&);
+     }
+     remove(fajlnev);
+     f = fopen(fajlnev, "wb");
+     fclose(f);
+     {
+       MappedText ures(fajlnev);
+       EXPECT_EQ((size_t)0, ures.getLength());
+       EXPECT_EQ(true, sha256(ures).digest() == sha256("").digest());
+     }
+     remove(fajlnev);
+     EXPECT_THROW(MappedText hianyzo(fajlnev), std::runtime_error const&);
+    } ENDM
+/**
+ * 8. Fordítási idejű SHA256 tesztelése.
+ * A static_assert miatt egy elgépelt hash már fordításkor kiderül.
+ */
+    TEST(Sha256, constexpr ) {
+     constexpr Digest abc = sha256_ct("abc");
+     static_assert(abc == Digest::fromHex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), "sha256_ct(\"abc\") hibas");
+     static_assert(sha256_ct("") == Digest::fromHex("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), "sha256_ct(\"\") hibas");
+     EXPECT_EQ(true, abc == sha256("abc").digest());
+     const char *hosszu = "hasheljük ezt mert miért ne, ez már több blokkos üzenet, hogy a padding is át legyen nézve";
+     EXPECT_EQ(true, sha256_ct(hosszu, strlen(hosszu)) == sha256(hosszu).digest());
+    } ENDM
+/**
+ * 1. HMAC-SHA256 és PBKDF2 tesztelése.
+ * RFC 4231 és RFC 7914 tesztvektorok.
+ */
+    TEST(Hmac, rfc4231 ) {
+     hmac_sha256 mac("Jefe");
+     mac.update("what do ya want ");
+     mac.update("for nothing?");
+     EXPECT_STREQ("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", mac.finalize().hex().c_string());
+     mac.update("what do ya want for nothing?");
+     EXPECT_STREQ("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", mac.finalize().hex().c_string());
+     uint8_t hosszu_kulcs[131];
+     for(size_t i = 0; i < sizeof(hosszu_kulcs); ++i) hosszu_kulcs[i] = 0xaa;
+     hmac_sha256 mac2(hosszu_kulcs, sizeof(hosszu_kulcs));
+     mac2.update("Test Using Larger Than Block-Size Key - Hash Key First");
+     EXPECT_STREQ("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54", mac2.finalize().hex().c_string());
+     Digest d = sha256("abc").digest();
+     hmac_sha256 mac3("Jefe");
+     mac3.update(d.data(), Digest::size);
+     EXPECT_EQ(true, mac3.finalize() == mac.mac32(d));
+    } ENDM
+
+    TEST(Hmac, pbkdf2 ) {
+     Vector<uint8_t> dk = pbkdf2_sha256("passwd", "salt", 1, 64);
+     Vector<uint8_t> elvart;
+     uint8_t tmp[] = {0x55, 0xac, 0x04, 0x6e, 0x56, 0xe3, 0x08, 0x9f, 0xec, 0x16, 0x91, 0xc2, 0x25, 0x44, 0xb6, 0x05,
+                      0xf9, 0x41, 0x85, 0x21, 0x6d, 0xde, 0x04, 0x65, 0xe6, 0x8b, 0x9d, 0x57, 0xc2, 0x0d, 0xac, 0xbc,
+                      0x49, 0xca, 0x9c, 0xcc, 0xf1, 0x79, 0xb6, 0x45, 0x99, 0x16, 0x64, 0xb3, 0x9d, 0x77, 0xef, 0x31,
+                      0x7c, 0x71, 0xb8, 0x45, 0xb1, 0xe3, 0x0b, 0xd5, 0x09, 0x11, 0x20, 0x41, 0xd3, 0xa1, 0x97, 0x83};
+     for(size_t i = 0; i < sizeof(tmp); ++i) elvart.push_back(tmp[i]);
+     EXPECT_EQ(true, dk == elvart);
+     Vector<uint8_t> dk2 = pbkdf2_sha256("password", "salt", 4096, 32);
+     uint8_t tmp2[] = {0xc5, 0xe4, 0x78, 0xd5, 0x92, 0x88, 0xc8, 0x41, 0xaa, 0x53, 0x0d, 0xb6, 0x84, 0x5c, 0x4c, 0x8d,
+                       0x96, 0x28, 0x93, 0xa0, 0x01, 0xce, 0x4e, 0x11, 0xa4, 0x96, 0x38, 0x73, 0xaa, 0x98, 0x13, 0x4a};
+     EXPECT_EQ(0, memcmp(tmp2, &dk2[0], 32));
+     EXPECT_THROW(pbkdf2_sha256("password", "salt", 0), std::invalid_argument const&);
+    } ENDM
+/**
+ * 1. Internáló tábla: egy szöveg egyszer tárolódik, az azonosítók pointerként hasonlíthatók.
+ */
+    TEST(Intern, pool ) {
+     InternPool pool;
+     Interned a = pool.intern("Valentin");
+     Interned b = pool.intern(String("Valentin"));
+     Interned c = pool.intern("Valentim");
+     EXPECT_EQ(true, a == b);
+     EXPECT_EQ(true, a != c);
+     EXPECT_EQ(a.c_string(), b.c_string());
+     EXPECT_STREQ("Valentin", a.c_string());
+     EXPECT_EQ(string_hash("Valentin"), a.hash());
+     EXPECT_EQ((size_t)2, pool.size());
+     EXPECT_EQ(true, pool.find("Valentin") == a);
+     EXPECT_EQ(true, pool.find("senki").empty());
+     EXPECT_EQ(true, pool.intern("") != pool.intern(String("\0", 1)));
+
+     /// Sok szöveg (a tábla többször újraméreteződik) és egy nagy, saját blokkot kapó szöveg.
+     String hosszu;
+     for(int i = 0; i < 2000; ++i) hosszu += "0123456789";
+     Interned h = pool.intern(hosszu);
+     bool ok = true;
+     Interned elso[100];
+     for(int i = 0; i < 20000; ++i){
+       Interned x = pool.intern(String("felhasznalo") + i);
+       if(i < 100) elso[i] = x;
+     }
+     for(int i = 0; i < 100; ++i){
+       ok = ok && pool.find(String("felhasznalo") + i) == elso[i];
+       ok = ok && StringView(elso[i]) == StringView(String(String("felhasznalo") + i));
+     }
+     EXPECT_EQ(true, ok);
+     EXPECT_EQ((size_t)20005, pool.size());
+     EXPECT_EQ(true, pool.intern(hosszu) == h);
+     EXPECT_EQ(true, h.view() == StringView(hosszu));
+     EXPECT_STREQ("Valentin", a.c_string());
+    } ENDM
 /**
  * 1. Fiók beléptetés tesztelése.
  */
     TEST(Account, login ) {
      Account fiok0("ca659234fe3bceeb51e1b4a0c01e43ae54180bf4a715858bebf6fe6277b3a939", "só", "0a90f84cd8fadb7b4a71c62db57b0d237a8fcf606ea1e61e3cc1980e04ad94db");
      EXPECT_EQ(true, fiok0.verify("Valentin", "almafa12"));
+     EXPECT_EQ(false, fiok0.verify("Valentin", "almafa13"));
+     EXPECT_EQ(false, fiok0.verify("Valentim", "almafa12"));
+
+    } ENDM
+/**
+ * 2. Só elöl séma, só midstate és verziózott rekord tesztelése.
+ */
+    TEST(Account, salt_prefix ) {
+     String so("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef-hosszu-so");
+     sha256_prefix salted(so);
+     sha256 egyben;
+     egyben.update(so);
+     egyben.update("almafa12");
+     EXPECT_EQ(true, salted.hash("almafa12") == egyben.finalize());
+     sha256 folytatas = salted.start();
+     folytatas.update("alma");
+     folytatas.update("fa12");
+     EXPECT_EQ(true, salted.hash("almafa12") == folytatas.finalize());
+
+     Account uj = Account::create("Valentin", so, "almafa12");
+     EXPECT_EQ(salt_prefix, uj.getScheme());
+     EXPECT_EQ(true, uj.verify("Valentin", "almafa12"));
+     EXPECT_EQ(false, uj.verify("Valentin", "almafa13"));
+     sha256_prefix fiok_so = uj.prefix();
+     EXPECT_EQ(true, uj.verify(fiok_so, "Valentin", "almafa12"));
+     EXPECT_EQ(false, uj.verify(fiok_so, "Valentim", "almafa12"));
+
+     Account visszaolvasott = Account::parse(uj.serialize());
+     EXPECT_EQ(salt_prefix, visszaolvasott.getScheme());
+     EXPECT_EQ(true, visszaolvasott.verify("Valentin", "almafa12"));
 
+     Account regi = Account::parse("ca659234fe3bceeb51e1b4a0c01e43ae54180bf4a715858bebf6fe6277b3a939$0a90f84cd8fadb7b4a71c62db57b0d237a8fcf606ea1e61e3cc1980e04ad94db$só");
+     EXPECT_EQ(salt_suffix, regi.getScheme());
+     EXPECT_EQ(true, regi.verify("Valentin", "almafa12"));
+     EXPECT_EQ(true, Account::parse(regi.serialize()).verify("Valentin", "almafa12"));
+     EXPECT_THROW(regi.prefix(), std::logic_error const&);
+     EXPECT_THROW(Account::parse("3$abc"), std::invalid_argument const&);
+     EXPECT_THROW(Account::parse("2$tul-rovid"), std::invalid_argument const&);
     } ENDM
 
 return 0;
@@ -1,119 +1,194 @@
 #include "sha256.h"
+#include "sha256_kernel.h"
 #include <cstdlib>
+#include <cstring>
+sha256::sha256(): block_len(0), bit_len(0){
+  for(size_t i = 0; i < 8; ++i){
+    h[i] = sha256_H0[i];
+  }
+}
+sha256::sha256(const StringView& _arg): sha256(){
+  update(_arg);
+}
+sha256::sha256(const uint8_t* data, size_t len): sha256(){
+  update(data, len);
+}
+sha256::sha256(Span<const uint8_t> _arg): sha256(){
+  update(_arg);
+}
+void sha256::update(const uint8_t* data, size_t len){
+  if(len == 0) return;
+  bit_len += (uint64_t)len*8;
+  /**
+   * Ha van félig töltött blokk, előbb azt egészítjük ki.
+   */
+  if(block_len > 0){
+    size_t n = 64 - block_len;
+    if(n > len) n = len;
+    memcpy(block + block_len, data, n);
+    block_len += n;
+    data += n;
+    len -= n;
+    if(block_len < 64) return;
+    sha256_compress(h, block, 1);
+    block_len = 0;
+  }
+  /**
+   * A teljes blokkokat egyetlen kernel hívással, közvetlenül a hívó bufferéből dolgozzuk fel.
+   */
+  size_t nblocks = len / 64;
+  if(nblocks > 0){
+    sha256_compress(h, data, nblocks);
+    data += nblocks*64;
+    len -= nblocks*64;
+  }
+  if(len > 0){
+    memcpy(block, data, len);
+    block_len = len;
+  }
+}
+void sha256::update(const StringView& _arg){
+  update((const uint8_t*)_arg.data(), _arg.getLength());
+}
+void sha256::update(Span<const uint8_t> _arg){
+  update(_arg.data(), _arg.size());
+}
+Digest sha256::finalize(){
+  /**
+   * Padding: egy 1-es bit, majd annyi 0, hogy a blokkban 56 byte legyen, végül az üzenet hossza big endianként.
+   */
+  uint64_t total = bit_len;
+  block[block_len++] = 0x80;
+  if(block_len > 56){
+    memset(block + block_len, 0, 64 - block_len);
+    sha256_compress(h, block, 1);
+    block_len = 0;
+  }
+  memset(block + block_len, 0, 56 - block_len);
+  for(size_t i = 0; i < 8; ++i){
+    block[56 + i] = (uint8_t)(total >> (56 - 8*i));
+  }
+  sha256_compress(h, block, 1);
+  Digest res;
+  uint8_t* out = res.data();
+  for(size_t i = 0; i < 8; ++i){
+    out[4*i] = (uint8_t)(h[i] >> 24);
+    out[4*i+1] = (uint8_t)(h[i] >> 16);
+    out[4*i+2] = (uint8_t)(h[i] >> 8);
+    out[4*i+3] = (uint8_t)h[i];
+  }
+  *this = sha256();
+  return res;
+}
+Digest sha256::digest() const{
+  sha256 tmp = *this;
+  return tmp.finalize();
+}
+String sha256::hexdigest() const{
+  return digest().hex();
+}
+Digest sha256_prefix::hash(const uint8_t* data, size_t len) const{
+  sha256 tmp = ctx;
+  tmp.update(data, len);
+  return tmp.finalize();
+}
+Digest sha256_prefix::hash(const StringView& data) const{
+  sha256 tmp = ctx;
+  tmp.update(data);
+  return tmp.finalize();
+}
+#if defined(SHA256_HAVE_AVX2)
 /**
-* Inicializáljuk a használt konstansok értékeket:
-* (első 32 bitje, az első 64 prím köbgyökének):
-*/
-const uint32_t K[64] = {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-                     0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-                     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-                     0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-                     0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-                     0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-                     0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-                     0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-                     0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-                     0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-                     0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-                     0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-                     0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-                     0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-                     0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-                     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
-
-
-endian sha256::e = endian_check();
-
-sha256::sha256(const String& _arg): digest(), arg(_arg){
-      size_t arg_length = arg.getLength();
-      size_t x = 0;
-      bool eightzero = true;
-      bool failed = false;
-      /**
-       * Inicializáljuk a hash értékeket:
-       * (első 32 bitje, az első 8 prím négyzetgyökének):
-       */
-      uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
-      /**
-       * Pre-processzálás
-       */
-      for(size_t j = 0; j < (arg_length+8)/64 + 1; ++j){
-        Vector<uint8_t> wa(64);
-        Vector<uint32_t> wd(64);
-        Vector<uint32_t> wv(8); //0=a, 1=b, 2=c, 3=d, 4=e, 5=f, 6=g, 7=h
+ * 8 üzenet hashelése egy-egy AVX2 lane-en.
+ * A teljes blokkokat közvetlenül az üzenetből olvassuk, a paddinget tartalmazó utolsó 1-2 blokkot lane-enként egy külön bufferben készítjük el.
+ * Ha egy lane üzenete hamarabb véget ér, a további körökben az állapotát visszaállítjuk.
+ */
+void sha256_many_x8(const sha256_message* msgs, Digest* digests){
+  uint32_t state[8][8];
+  uint8_t tail[8][128];
+  size_t full[8], nblocks[8];
+  size_t max_blocks = 0;
+  for(size_t lane = 0; lane < 8; ++lane){
+    for(size_t i = 0; i < 8; ++i){
+      state[i][lane] = sha256_H0[i];
+    }
+    size_t len = msgs[lane].len;
+    size_t rem = len % 64;
+    full[lane] = len / 64;
+    size_t tail_blocks = (rem < 56) ? 1 : 2;
+    memset(tail[lane], 0, sizeof(tail[lane]));
+    if(rem > 0) memcpy(tail[lane], msgs[lane].data + full[lane]*64, rem);
+    tail[lane][rem] = 0x80;
+    uint64_t bits = (uint64_t)len*8;
+    for(size_t i = 0; i < 8; ++i){
+      tail[lane][tail_blocks*64 - 8 + i] = (uint8_t)(bits >> (56 - 8*i));
+    }
+    nblocks[lane] = full[lane] + tail_blocks;
+    if(nblocks[lane] > max_blocks) max_blocks = nblocks[lane];
+  }
+  for(size_t b = 0; b < max_blocks; ++b){
+    const uint8_t* blocks[8];
+    uint32_t saved[8][8];
+    for(size_t lane = 0; lane < 8; ++lane){
+      if(b < full[lane]) blocks[lane] = msgs[lane].data + b*64;
+      else if(b < nblocks[lane]) blocks[lane] = tail[lane] + (b - full[lane])*64;
+      else{
+        blocks[lane] = tail[lane];
         for(size_t i = 0; i < 8; ++i){
-            wv[i] = h[i];
-        }
-        
-         for(Vector<uint8_t>::iterator iter = wa.begin(); iter != wa.end(); ++iter){
-          try{
-            (*iter) = arg[x];
-            x++;
-          }
-          catch(std::out_of_range const&){
-            failed = true;
-            break;
-          }
-        }
-        size_t i = (eightzero)? (x % 64):0; 
-        if(failed){
-          if(eightzero) wa[i++] = 0x80;
-          if(i <= 56){
-            (*(uint64_t*)(&wa[56])) = arg_length*8;  
-            if(e == little) reverse_byte_order(&wa[56], sizeof(uint64_t));
-          }    
-          while(i != 56 && i!= 64){
-            wa[i++] = 0x00;
-          }
-          eightzero = false;
-        }
-        /**
-         * 64db 8 bites adat feldolgozása mint 16db 32 bites adat
-         */
-        for(size_t i = 0; i < 16; ++i){
-          if(e == little) reverse_byte_order(&wa[4*i], sizeof(uint32_t));
-          wd[i] = *(uint32_t*)&wa[4*i];
-        }
-        /**
-         * Hashelés folyamata
-         */
-        dir d = right;
-        for(size_t i = 16; i < 64; ++i){
-          uint32_t ro0 = (rotate(wd[i-15], sizeof(uint32_t), 7,d) ^ rotate(wd[i-15], sizeof(uint32_t), 18,d)) ^ (wd[i-15] >> 3);
-          uint32_t ro1 = (rotate(wd[i-2], sizeof(uint32_t), 17,d) ^ rotate(wd[i-2], sizeof(uint32_t), 19,d)) ^ (wd[i-2] >> 10);
-          wd[i] = ro0 + ro1 + wd[i-16] + wd[i-7];
-        }
-        for(size_t i = 0; i < 64; ++i){
-          uint32_t sum0 = (rotate(wv[0], sizeof(uint32_t), 2,d) ^ rotate(wv[0], sizeof(uint32_t), 13,d)) ^ rotate(wv[0], sizeof(uint32_t), 22,d);
-          uint32_t sum1 = (rotate(wv[4], sizeof(uint32_t), 6,d) ^ rotate(wv[4], sizeof(uint32_t), 11,d)) ^ rotate(wv[4], sizeof(uint32_t), 25,d);
-          uint32_t choice = (wv[4] & wv[5]) ^ ((~wv[4]) & wv[6]);
-          uint32_t majority = (wv[0] & wv[1]) ^ (wv[0] & wv[2]) ^ (wv[2] & wv[1]);
-          uint32_t temp1 = wv[7] + sum1  + choice + K[i] + wd[i];
-          uint32_t temp2 = sum0 + majority;
-          
-          for(size_t j = 7; j>0; --j){
-            if(j != 4) wv[j] = wv[j-1];  
-            else wv[j] = wv[j-1] + temp1;
-          }
-          wv[0] = temp1 + temp2;
+          saved[i][lane] = state[i][lane];
         }
-        
+      }
+    }
+    sha256_compress_x8_avx2(state, blocks);
+    for(size_t lane = 0; lane < 8; ++lane){
+      if(b >= nblocks[lane]){
         for(size_t i = 0; i < 8; ++i){
-            h[i] += wv[i];
+          state[i][lane] = saved[i][lane];
         }
       }
-      /**
-       * Hash értékének kimentése Stringbe
-       */
-      for(size_t i = 0; i < 8; ++i){
-          digest += h[i];
-      }
+    }
+  }
+  for(size_t lane = 0; lane < 8; ++lane){
+    uint8_t* out = digests[lane].data();
+    for(size_t i = 0; i < 8; ++i){
+      out[4*i] = (uint8_t)(state[i][lane] >> 24);
+      out[4*i+1] = (uint8_t)(state[i][lane] >> 16);
+      out[4*i+2] = (uint8_t)(state[i][lane] >> 8);
+      out[4*i+3] = (uint8_t)state[i][lane];
+    }
+  }
 }
-void sha256::update(const String& _arg){
-  *this = sha256(arg + _arg);
+#endif
+/**
+ * Igaz, ha a sha256_many a 8 lane-es AVX2 utat használja.
+ * SHA-NI mellett az üzenetenkénti hardveres kernel gyorsabb a 8 lane-es AVX2 kernelnél, így az AVX2 utat csak SHA-NI nélkül használjuk.
+ */
+static bool many_uses_x8(){
+#if defined(SHA256_HAVE_AVX2)
+  static const bool x8 = cpu_has_avx2() && !cpu_has_shani();
+  return x8;
+#else
+  return false;
+#endif
 }
-String sha256::hexdigest() const{
-  return digest;
+const char* sha256_many_path(){
+  return many_uses_x8() ? "x8_avx2" : "single";
+}
+void sha256_many(const sha256_message* msgs, size_t n, Digest* digests){
+  size_t i = 0;
+#if defined(SHA256_HAVE_AVX2)
+  if(many_uses_x8()){
+    for(; i + 8 <= n; i += 8){
+      sha256_many_x8(msgs + i, digests + i);
+    }
+  }
+#endif
+  /**
+   * A maradék (és AVX2 nélkül vagy SHA-NI-vel az összes) üzenet egyesével.
+   */
+  for(; i < n; ++i){
+    sha256 ctx;
+    ctx.update(msgs[i].data, msgs[i].len);
+    digests[i] = ctx.finalize();
+  }
 }
-
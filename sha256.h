@@ -1,8 +1,10 @@
 #ifndef SHA256
 #define SHA256
 #include "string.h"
+#include "digest.h"
 #include <cstdint>
 #include "vector.hpp"
+#include "cpu.h"
 /**
  * @file sha256.h
  * Az sha256 osztály header fájlja, ami tartalmaz az sha256 által használt egyéb globális függvények deklarációját is.
@@ -51,50 +53,299 @@ void reverse_byte_order(T *buf, size_t buf_size){
 /**
  * Egy bitsorozaton végez forgatást.
  * Lényegében bit shift jobbra / balra, csak a kilépő bitek a legnagyobb / legkisebb helyiértékeken visszakerülnek. 
+ * constexpr, így fordítási időben is kiértékelhető.
  * @param buf a forgatandó bitsorozat.
  * @param buf_size a bitsorozat mérete.
  * @param rotN a forgatás hányszorosa.
  * @param d a forgatás iránya.
  */
 template <typename T>
-T rotate(const T& buf, size_t buf_size, int rotN, dir d){
+constexpr T rotate(const T& buf, size_t buf_size, int rotN, dir d){
   switch(d){
     case right:
         return (buf >> rotN) | (buf << (buf_size*8-rotN));
-        break;
     case left:
         return (buf << rotN) | (buf >> (buf_size*8-rotN));
-        break;
     default:
         return buf;
   }
 }
+/**
+* Inicializáljuk a használt konstansok értékeket:
+* (első 32 bitje, az első 64 prím köbgyökének):
+*/
+constexpr uint32_t sha256_K[64] = {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+                     0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                     0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+                     0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                     0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+                     0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                     0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+                     0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                     0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+                     0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                     0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+                     0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                     0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+                     0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                     0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+                     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+/**
+ * Inicializáljuk a hash értékeket:
+ * (első 32 bitje, az első 8 prím négyzetgyökének):
+ */
+constexpr uint32_t sha256_H0[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+/**
+ * Az SHA256 körfüggvényeinek segédfüggvényei, a szabvány jelöléseivel.
+ */
+constexpr uint32_t sha256_Sigma0(uint32_t x){
+  return rotate(x, sizeof(uint32_t), 2, right) ^ rotate(x, sizeof(uint32_t), 13, right) ^ rotate(x, sizeof(uint32_t), 22, right);
+}
+constexpr uint32_t sha256_Sigma1(uint32_t x){
+  return rotate(x, sizeof(uint32_t), 6, right) ^ rotate(x, sizeof(uint32_t), 11, right) ^ rotate(x, sizeof(uint32_t), 25, right);
+}
+constexpr uint32_t sha256_sigma0(uint32_t x){
+  return rotate(x, sizeof(uint32_t), 7, right) ^ rotate(x, sizeof(uint32_t), 18, right) ^ (x >> 3);
+}
+constexpr uint32_t sha256_sigma1(uint32_t x){
+  return rotate(x, sizeof(uint32_t), 17, right) ^ rotate(x, sizeof(uint32_t), 19, right) ^ (x >> 10);
+}
+/**
+ * Egy kör: a regisztereket nem toljuk el, hanem a makró paramétereinek sorrendjét forgatjuk.
+ * Az üzenet ütemezést (message schedule) egy 16 szavas gyűrűben, menet közben számoljuk.
+ */
+#define SHA256_SCHED(i) \
+  W[(i)&15] += sha256_sigma1(W[((i)-2)&15]) + W[((i)-7)&15] + sha256_sigma0(W[((i)-15)&15])
+#define SHA256_ROUND(a,b,c,d,e,f,g,h,i) { \
+  uint32_t t1 = h + sha256_Sigma1(e) + ((e & f) ^ (~e & g)) + sha256_K[i] + W[(i)&15]; \
+  uint32_t t2 = sha256_Sigma0(a) + ((a & b) ^ (a & c) ^ (b & c)); \
+  d += t1; \
+  h = t1 + t2; }
+#define SHA256_ROUND8(i) \
+  SHA256_ROUND(a,b,c,d,e,f,g,h,(i)+0) SHA256_ROUND(h,a,b,c,d,e,f,g,(i)+1) \
+  SHA256_ROUND(g,h,a,b,c,d,e,f,(i)+2) SHA256_ROUND(f,g,h,a,b,c,d,e,(i)+3) \
+  SHA256_ROUND(e,f,g,h,a,b,c,d,(i)+4) SHA256_ROUND(d,e,f,g,h,a,b,c,(i)+5) \
+  SHA256_ROUND(c,d,e,f,g,h,a,b,(i)+6) SHA256_ROUND(b,c,d,e,f,g,h,a,(i)+7)
+#define SHA256_SCHED_ROUND8(i) \
+  SHA256_SCHED((i)+0); SHA256_ROUND(a,b,c,d,e,f,g,h,(i)+0) SHA256_SCHED((i)+1); SHA256_ROUND(h,a,b,c,d,e,f,g,(i)+1) \
+  SHA256_SCHED((i)+2); SHA256_ROUND(g,h,a,b,c,d,e,f,(i)+2) SHA256_SCHED((i)+3); SHA256_ROUND(f,g,h,a,b,c,d,e,(i)+3) \
+  SHA256_SCHED((i)+4); SHA256_ROUND(e,f,g,h,a,b,c,d,(i)+4) SHA256_SCHED((i)+5); SHA256_ROUND(d,e,f,g,h,a,b,c,(i)+5) \
+  SHA256_SCHED((i)+6); SHA256_ROUND(c,d,e,f,g,h,a,b,(i)+6) SHA256_SCHED((i)+7); SHA256_ROUND(b,c,d,e,f,g,h,a,(i)+7)
+/**
+ * Egy blokk 64 körének teljesen kifejtett (unrolled) feldolgozása, már szavakra bontott üzenetből.
+ * Ezt használja a futásidejű skalár kernel és a fordítási idejű sha256_ct is, így a kör kódja közös.
+ * @param state a láncolt hash állapot, ezt frissíti.
+ * @param W a blokk 16 big endian szava; a függvény felülírja (üzenet ütemezés).
+ */
+constexpr void sha256_compress_words(uint32_t state[8], uint32_t W[16]){
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+  uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+  SHA256_ROUND8(0) SHA256_ROUND8(8)
+  SHA256_SCHED_ROUND8(16) SHA256_SCHED_ROUND8(24)
+  SHA256_SCHED_ROUND8(32) SHA256_SCHED_ROUND8(40)
+  SHA256_SCHED_ROUND8(48) SHA256_SCHED_ROUND8(56)
+  state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+  state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+#undef SHA256_SCHED
+#undef SHA256_ROUND
+#undef SHA256_ROUND8
+#undef SHA256_SCHED_ROUND8
+/**
+ * Fordítási idejű SHA256.
+ * constexpr környezetben (pl. constexpr változó, static_assert) a fordító számolja ki a hash-t, így nincs futásidejű költsége.
+ * Ugyanazt a kör kódot (sha256_compress_words) használja, mint a futásidejű skalár kernel.
+ * @param str a hashelendő byte-ok.
+ * @param len a byte-ok száma.
+ * @return Digest.
+ */
+constexpr Digest sha256_ct(const char* str, size_t len){
+  uint32_t state[8] = {sha256_H0[0], sha256_H0[1], sha256_H0[2], sha256_H0[3],
+                       sha256_H0[4], sha256_H0[5], sha256_H0[6], sha256_H0[7]};
+  size_t nblocks = (len + 8) / 64 + 1;
+  uint64_t bits = (uint64_t)len*8;
+  for(size_t b = 0; b < nblocks; ++b){
+    uint32_t W[16] = {};
+    for(size_t i = 0; i < 64; ++i){
+      size_t pos = b*64 + i;
+      uint32_t byte = 0;
+      if(pos < len) byte = (uint8_t)str[pos];
+      else if(pos == len) byte = 0x80;
+      else if(b == nblocks - 1 && i >= 56) byte = (uint8_t)(bits >> (8*(63 - i)));
+      W[i/4] |= byte << (24 - 8*(i%4));
+    }
+    sha256_compress_words(state, W);
+  }
+  Digest res;
+  for(size_t i = 0; i < 8; ++i){
+    res.data()[4*i] = (uint8_t)(state[i] >> 24);
+    res.data()[4*i+1] = (uint8_t)(state[i] >> 16);
+    res.data()[4*i+2] = (uint8_t)(state[i] >> 8);
+    res.data()[4*i+3] = (uint8_t)state[i];
+  }
+  return res;
+}
+/**
+ * Fordítási idejű SHA256 string literálra, a lezáró '\0' nélkül.
+ * Pl.: constexpr Digest d = sha256_ct("abc");
+ * @param str string literál.
+ * @return Digest.
+ */
+template <size_t N>
+constexpr Digest sha256_ct(const char (&str)[N]){
+  return sha256_ct(str, N - 1);
+}
 /**
  * SHA256 hash függvény.
  * Az SHA256-os hash függvényt megvalósító osztály, amellyel tetszőleges hosszú Stringeket tudunk hashelni.
+ * Valódi streamelő kontextus: csak a 8 szavas láncolt állapotot, egy legfeljebb 64 byte-os részleges blokkot
+ * és egy bitszámlálót tárol, így az input darabokban is átadható anélkül, hogy a teljes üzenetet meg kellene őrizni.
+ * A blokkok feldolgozását a futásidőben kiválasztott kernel végzi (lásd sha256_kernel.h).
  */
 class sha256{
-  String digest; /**< a 256 bites hexadecimális hash-t tároló String.*/
-  String arg; /**< a hash-hez tartozó input String.*/
-  static endian e; /**< endiannes-t tároló statikus változó.*/
+  uint32_t h[8]; /**< a láncolt hash állapot (a..h regiszterek kezdőértékei a következő blokkhoz).*/
+  uint8_t block[64]; /**< a még fel nem dolgozott, részleges blokk.*/
+  size_t block_len; /**< a részleges blokkban lévő byte-ok száma.*/
+  uint64_t bit_len; /**< az eddig feldolgozott üzenet hossza bitben.*/
+  friend class hmac_sha256; /**< a HMAC a kulcs blokkok utáni láncolt állapotot (midstate) közvetlenül olvassa.*/
 
   public:
+  /**
+   * Paraméter nélküli konstruktor.
+   * Üres kontextust hoz létre, amihez az update függvénnyel lehet adatot hozzáadni.
+   */
+  sha256();
+  /**
+   * Konstruktor.
+   * Egylépéses hasheléshez: inicializálja a kontextust, majd hozzáadja az inputot.
+   * Nézetet kap, így String, C-sztring és MappedText is hashelhető másolás nélkül.
+   * @param input a hashelendő szöveg nézete.
+   */
+  sha256(const StringView&);
+  /**
+   * Konstruktor.
+   * Egylépéses hasheléshez, tetszőleges (akár '\0'-t is tartalmazó) byte sorozatra.
+   * @param data a byte-ok kezdőcíme.
+   * @param len a byte-ok száma.
+   */
+  sha256(const uint8_t* data, size_t len);
   /**
    * Konstruktor.
-   * Lényegében ez tartalmazza a hash-elő függvényt.
-   * @param input String.
+   * Egylépéses hasheléshez, pl. egy Cipher::encode által visszaadott titkosított szövegre.
+   * Bármilyen byte tömb nézete átadható (Vector<uint8_t>, Ciphertext, SmallVector).
+   * @param input a byte-ok nézete.
+   */
+  sha256(Span<const uint8_t>);
+  /**
+   * Hozzáadja a kontextushoz a következő adatdarabot.
+   * Előbb a részleges blokkot tölti fel, utána a teljes blokkokat másolás nélkül, közvetlenül a hívó memóriájából dolgozza fel,
+   * végül a maradékot a részleges blokkban tartja. Nem dob exceptiont.
+   * @param data a byte-ok kezdőcíme.
+   * @param len a byte-ok száma.
    */
-  sha256(const String&);
+  void update(const uint8_t* data, size_t len);
   /**
-   * Lecseréli a digest-et egy új hash-el.
-   * Az eddigi arg-hoz hozzá fűz egy másik Stringet, majd ezt az új arg-on újra futtatja a hash függvényt, és frissíti a digestet ez által.
-   * @param a hozzáfűzendő String.
+   * Hozzáfűz egy szöveget (String, C-sztring, MappedText) az eddig hashelt adathoz.
+   * A nézet hosszát használja, nem a lezáró '\0'-t keresi.
+   * @param a hozzáfűzendő szöveg nézete.
    */
-  void update(const String&);
+  void update(const StringView&);
   /**
-   * Visszadja a digest Stringet.
+   * Hozzáfűz egy byte tömböt az eddig hashelt adathoz.
+   * @param a hozzáfűzendő byte-ok nézete.
+   */
+  void update(Span<const uint8_t>);
+  /**
+   * Lezárja a hashelést: elvégzi a paddinget és visszaadja a 32 byte-os hash értéket.
+   * Utána a kontextus újra üres állapotba kerül, tehát újrahasználható.
+   * @return Digest.
+   */
+  Digest finalize();
+  /**
+   * Visszadja az eddig hozzáadott adat bináris hash-ét.
+   * A kontextust nem módosítja, tehát utána is folytatható az update. Nem foglal dinamikus memóriát.
+   * @return Digest.
+   */
+  Digest digest() const;
+  /**
+   * Visszadja az eddig hozzáadott adat hash-ét hexadecimális Stringként.
+   * A kontextust nem módosítja, tehát utána is folytatható az update.
    * @return String.
    */
   String hexdigest() const;
 };
+/**
+ * Előre feldolgozott prefix (pl. só) midstate-je.
+ * A konstruktor egyszer hasheli a prefixet (a teljes blokkjait tömöríti), utána minden jelölthöz ennek az állapotnak
+ * egy másolatából indulunk, így ugyanazzal a prefix-szel kezdődő sok üzenetnél a prefix blokkjait csak egyszer dolgozzuk fel.
+ * Csak 64 byte-nál hosszabb prefixnél spórol tömörítést; rövidebbnél a másolás és összefűzés elmaradása a nyereség.
+ */
+class sha256_prefix{
+  sha256 ctx; /**< a prefix feldolgozása utáni kontextus.*/
+  public:
+  /**
+   * Konstruktor.
+   * @param data a prefix kezdőcíme.
+   * @param len a prefix hossza byte-ban.
+   */
+  sha256_prefix(const uint8_t* data, size_t len): ctx(data, len){}
+  /**
+   * Konstruktor.
+   * @param prefix a prefix szöveg.
+   */
+  explicit sha256_prefix(const StringView& prefix): ctx(prefix){}
+  /**
+   * Visszaad egy, a prefix utáni állapotból induló kontextust, amit tovább lehet folytatni.
+   * @return sha256.
+   */
+  sha256 start() const{
+    return ctx;
+  }
+  /**
+   * A prefix || data hash-e.
+   * @param data a byte-ok kezdőcíme.
+   * @param len a byte-ok száma.
+   * @return Digest.
+   */
+  Digest hash(const uint8_t* data, size_t len) const;
+  /**
+   * A prefix || data hash-e.
+   * @param data a prefix után fűzendő szöveg.
+   * @return Digest.
+   */
+  Digest hash(const StringView& data) const;
+};
+/**
+ * Egy hashelendő üzenet a kötegelt (batch) API számára: byte-ok kezdőcíme és hossza.
+ */
+struct sha256_message{
+  const uint8_t* data; /**< az üzenet első byte-jára mutató pointer.*/
+  size_t len; /**< az üzenet hossza byte-ban.*/
+};
+/**
+ * Sok független (tipikusan rövid) üzenet kötegelt hashelése.
+ * Ha a processzor támogatja az AVX2-t, de SHA-NI nincs, 8-asával AVX2 lane-eken párhuzamosan hashel, a maradékot egyesével;
+ * SHA-NI-vel minden üzenetet egyesével, a hardveres kernellel.
+ * Az eredmény megegyezik azzal, mintha minden üzenetet külön sha256 objektummal hashelnénk.
+ * @param msgs az üzenetek tömbje.
+ * @param n az üzenetek száma.
+ * @param digests n darab kimeneti hash.
+ */
+void sha256_many(const sha256_message* msgs, size_t n, Digest* digests);
+/**
+ * Visszadja, melyik utat választja a sha256_many ezen a processzoron: "x8_avx2" vagy "single" (üzenetenként a kiválasztott kernellel).
+ * @return const char*.
+ */
+const char* sha256_many_path();
+#if defined(CPU_X86)
+/**
+ * Pontosan 8 üzenet hashelése a 8 lane-es AVX2 kernellel, a sha256_many választásától függetlenül.
+ * A tesztek és a mérések így SHA-NI-s processzoron is lefuttatják az AVX2 utat.
+ * Csak akkor hívható, ha a cpu_has_avx2() igazat ad.
+ * @param msgs a 8 üzenet.
+ * @param digests a 8 kimeneti hash.
+ */
+void sha256_many_x8(const sha256_message* msgs, Digest* digests);
+#endif
 #endif
@@ -0,0 +1,202 @@
+#include "sha256_kernel.h"
+#include "sha256.h"
+#if defined(SHA256_HAVE_SHANI)
+#include <immintrin.h>
+#endif
+static inline uint32_t load_be32(const uint8_t* p){
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/**
+ * A körök kódja közös a fordítási idejű sha256_ct-vel (sha256_compress_words, sha256.h).
+ */
+void sha256_compress_scalar(uint32_t state[8], const uint8_t* blocks, size_t nblocks){
+  for(; nblocks > 0; --nblocks, blocks += 64){
+    uint32_t W[16];
+    for(size_t i = 0; i < 16; ++i){
+      W[i] = load_be32(blocks + 4*i);
+    }
+    sha256_compress_words(state, W);
+  }
+}
+
+#if defined(SHA256_HAVE_SHANI)
+/**
+ * SHA-NI kernel.
+ * Az állapotot ABEF / CDGH elrendezésben tartja két xmm regiszterben, mert a sha256rnds2 így várja.
+ * Minden 4 körös csoportban: K hozzáadása, 2x2 kör, közben a következő üzenetszavak előkészítése (msg1/msg2).
+ */
+#define SHANI_RNDS(msg, i) \
+  MSG = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i*)&sha256_K[4*(i)])); \
+  STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);
+#define SHANI_MSG2(cur, prev, next) \
+  TMP = _mm_alignr_epi8(cur, prev, 4); \
+  next = _mm_add_epi32(next, TMP); \
+  next = _mm_sha256msg2_epu32(next, cur);
+#define SHANI_RNDS_HI() \
+  MSG = _mm_shuffle_epi32(MSG, 0x0E); \
+  STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG);
+#define SHANI_MSG1(prev, cur) \
+  prev = _mm_sha256msg1_epu32(prev, cur);
+
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256_compress_shani(uint32_t state[8], const uint8_t* blocks, size_t nblocks){
+  const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  __m128i STATE0, STATE1, MSG, TMP, MSG0, MSG1, MSG2, MSG3, ABEF_SAVE, CDGH_SAVE;
+
+  TMP = _mm_loadu_si128((const __m128i*)&state[0]);
+  STATE1 = _mm_loadu_si128((const __m128i*)&state[4]);
+  TMP = _mm_shuffle_epi32(TMP, 0xB1);          // CDAB
+  STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);    // EFGH
+  STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);    // ABEF
+  STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0); // CDGH
+
+  for(; nblocks > 0; --nblocks, blocks += 64){
+    ABEF_SAVE = STATE0;
+    CDGH_SAVE = STATE1;
+
+    MSG0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 0)), MASK);
+    SHANI_RNDS(MSG0, 0) SHANI_RNDS_HI()
+    MSG1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 16)), MASK);
+    SHANI_RNDS(MSG1, 1) SHANI_RNDS_HI() SHANI_MSG1(MSG0, MSG1)
+    MSG2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 32)), MASK);
+    SHANI_RNDS(MSG2, 2) SHANI_RNDS_HI() SHANI_MSG1(MSG1, MSG2)
+    MSG3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 48)), MASK);
+    SHANI_RNDS(MSG3, 3) SHANI_MSG2(MSG3, MSG2, MSG0) SHANI_RNDS_HI() SHANI_MSG1(MSG2, MSG3)
+
+    SHANI_RNDS(MSG0, 4) SHANI_MSG2(MSG0, MSG3, MSG1) SHANI_RNDS_HI() SHANI_MSG1(MSG3, MSG0)
+    SHANI_RNDS(MSG1, 5) SHANI_MSG2(MSG1, MSG0, MSG2) SHANI_RNDS_HI() SHANI_MSG1(MSG0, MSG1)
+    SHANI_RNDS(MSG2, 6) SHANI_MSG2(MSG2, MSG1, MSG3) SHANI_RNDS_HI() SHANI_MSG1(MSG1, MSG2)
+    SHANI_RNDS(MSG3, 7) SHANI_MSG2(MSG3, MSG2, MSG0) SHANI_RNDS_HI() SHANI_MSG1(MSG2, MSG3)
+    SHANI_RNDS(MSG0, 8) SHANI_MSG2(MSG0, MSG3, MSG1) SHANI_RNDS_HI() SHANI_MSG1(MSG3, MSG0)
+    SHANI_RNDS(MSG1, 9) SHANI_MSG2(MSG1, MSG0, MSG2) SHANI_RNDS_HI() SHANI_MSG1(MSG0, MSG1)
+    SHANI_RNDS(MSG2, 10) SHANI_MSG2(MSG2, MSG1, MSG3) SHANI_RNDS_HI() SHANI_MSG1(MSG1, MSG2)
+    SHANI_RNDS(MSG3, 11) SHANI_MSG2(MSG3, MSG2, MSG0) SHANI_RNDS_HI() SHANI_MSG1(MSG2, MSG3)
+    SHANI_RNDS(MSG0, 12) SHANI_MSG2(MSG0, MSG3, MSG1) SHANI_RNDS_HI() SHANI_MSG1(MSG3, MSG0)
+    SHANI_RNDS(MSG1, 13) SHANI_MSG2(MSG1, MSG0, MSG2) SHANI_RNDS_HI()
+    SHANI_RNDS(MSG2, 14) SHANI_MSG2(MSG2, MSG1, MSG3) SHANI_RNDS_HI()
+    SHANI_RNDS(MSG3, 15) SHANI_RNDS_HI()
+
+    STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+    STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+  }
+
+  TMP = _mm_shuffle_epi32(STATE0, 0x1B);       // FEBA
+  STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);    // DCHG
+  STATE0 = _mm_blend_epi16(TMP, STATE1, 0xF0); // DCBA
+  STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);    // HGFE
+  _mm_storeu_si128((__m128i*)&state[0], STATE0);
+  _mm_storeu_si128((__m128i*)&state[4], STATE1);
+}
+
+/**
+ * Multi-buffer AVX2 kernel.
+ * Minden ymm regiszter 8 lane-t tartalmaz, a lane-ek egymástól független üzenetek.
+ * A blokkokat soronként (lane-enként) töltjük be, majd egy 8x8-as transzponálással szavanként rendezzük.
+ */
+__attribute__((target("avx2")))
+static inline __m256i rotr_x8(__m256i x, int n){
+  return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+__attribute__((target("avx2")))
+static inline void transpose_x8(__m256i r[8]){
+  __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+  __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+__attribute__((target("avx2")))
+void sha256_compress_x8_avx2(uint32_t state[8][8], const uint8_t* const blocks[8]){
+  const __m256i BSWAP = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  __m256i W[16];
+  for(size_t half = 0; half < 2; ++half){
+    for(size_t lane = 0; lane < 8; ++lane){
+      W[8*half + lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(blocks[lane] + 32*half)), BSWAP);
+    }
+    transpose_x8(W + 8*half);
+  }
+  __m256i v[8];
+  for(size_t i = 0; i < 8; ++i){
+    v[i] = _mm256_loadu_si256((const __m256i*)state[i]);
+  }
+  __m256i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+  for(size_t i = 0; i < 64; ++i){
+    if(i >= 16){
+      __m256i w15 = W[(i-15)&15], w2 = W[(i-2)&15];
+      __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8(w15, 7), rotr_x8(w15, 18)), _mm256_srli_epi32(w15, 3));
+      __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8(w2, 17), rotr_x8(w2, 19)), _mm256_srli_epi32(w2, 10));
+      W[i&15] = _mm256_add_epi32(_mm256_add_epi32(W[i&15], s0), _mm256_add_epi32(W[(i-7)&15], s1));
+    }
+    __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8(e, 6), rotr_x8(e, 11)), rotr_x8(e, 25));
+    __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, _mm256_add_epi32(_mm256_set1_epi32((int)sha256_K[i]), W[i&15])));
+    __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(rotr_x8(a, 2), rotr_x8(a, 13)), rotr_x8(a, 22));
+    __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    __m256i t2 = _mm256_add_epi32(S0, maj);
+    h = g; g = f; f = e;
+    e = _mm256_add_epi32(d, t1);
+    d = c; c = b; b = a;
+    a = _mm256_add_epi32(t1, t2);
+  }
+  v[0] = _mm256_add_epi32(v[0], a); v[1] = _mm256_add_epi32(v[1], b);
+  v[2] = _mm256_add_epi32(v[2], c); v[3] = _mm256_add_epi32(v[3], d);
+  v[4] = _mm256_add_epi32(v[4], e); v[5] = _mm256_add_epi32(v[5], f);
+  v[6] = _mm256_add_epi32(v[6], g); v[7] = _mm256_add_epi32(v[7], h);
+  for(size_t i = 0; i < 8; ++i){
+    _mm256_storeu_si256((__m256i*)state[i], v[i]);
+  }
+}
+
+#endif
+
+/**
+ * Kernel választás.
+ * Az első híváskor fut le: kiválasztja a legjobb elérhető kernelt, beírja a sha256_compress pointerbe, majd meghívja.
+ */
+static void sha256_compress_resolve(uint32_t state[8], const uint8_t* blocks, size_t nblocks);
+sha256_compress_fn sha256_compress = sha256_compress_resolve;
+
+static sha256_compress_fn sha256_select(){
+#if defined(SHA256_HAVE_SHANI)
+  if(cpu_has_shani()) return sha256_compress_shani;
+#endif
+  return sha256_compress_scalar;
+}
+static void sha256_compress_resolve(uint32_t state[8], const uint8_t* blocks, size_t nblocks){
+  sha256_compress = sha256_select();
+  sha256_compress(state, blocks, nblocks);
+}
+/**
+ * Statikus inicializáláskor kiválasztjuk a kernelt, így már az első hash sem a feloldón keresztül fut.
+ */
+static const sha256_compress_fn sha256_startup = (sha256_compress = sha256_select());
+
+const char* sha256_kernel_name(){
+  sha256_compress_fn fn = (sha256_compress == sha256_compress_resolve) ? sha256_select() : sha256_compress;
+#if defined(SHA256_HAVE_SHANI)
+  if(fn == sha256_compress_shani) return "shani";
+#endif
+  return "scalar";
+}
@@ -0,0 +1,58 @@
+#ifndef SHA256_KERNEL
+#define SHA256_KERNEL
+#include <cstddef>
+#include <cstdint>
+#include "cpu.h"
+/**
+ * @file sha256_kernel.h
+ * Az SHA256 tömörítő függvény (compression function) különböző megvalósításainak header fájlja.
+ * A kernelek közül a program indulásakor, a processzor képességei (CPUID) alapján egyszer választunk,
+ * a hashelő API (sha256 osztály) pedig mindig a kiválasztott kernelt hívja.
+ */
+
+/**
+ * Tömörítő függvény típusa.
+ * Egymás utáni 64 byte-os blokkokat dolgoz fel, és frissíti velük a 8 szavas láncolt állapotot.
+ * @param state a láncolt hash állapot (a..h).
+ * @param blocks az első blokk első byte-jára mutató pointer, nem kell igazítva lennie.
+ * @param nblocks a feldolgozandó blokkok száma.
+ */
+typedef void (*sha256_compress_fn)(uint32_t state[8], const uint8_t* blocks, size_t nblocks);
+
+/**
+ * Hordozható, teljesen kifejtett (unrolled) skalár kernel.
+ * Minden architektúrán elérhető, ez a tartalék, ha nincs hardveres gyorsítás.
+ */
+void sha256_compress_scalar(uint32_t state[8], const uint8_t* blocks, size_t nblocks);
+
+#if defined(CPU_X86)
+#define SHA256_HAVE_SHANI
+/**
+ * Az x86 SHA kiterjesztéseit (sha256rnds2, sha256msg1, sha256msg2) használó kernel.
+ * Csak akkor hívható, ha a cpu_has_shani() igazat ad.
+ */
+void sha256_compress_shani(uint32_t state[8], const uint8_t* blocks, size_t nblocks);
+#define SHA256_HAVE_AVX2
+/**
+ * Multi-buffer AVX2 kernel: 8 független üzenet egy-egy blokkját dolgozza fel párhuzamosan, 8 lane-en.
+ * Az állapot transzponált elrendezésű: state[i][lane] a lane-edik üzenet i-edik állapotszava,
+ * így egy szó mind a 8 lane-je egyetlen ymm regiszterbe tölthető.
+ * Csak akkor hívható, ha a cpu_has_avx2() igazat ad.
+ * @param state a 8 üzenet láncolt állapota.
+ * @param blocks lane-enként a feldolgozandó 64 byte-os blokk címe.
+ */
+void sha256_compress_x8_avx2(uint32_t state[8][8], const uint8_t* const blocks[8]);
+#endif
+
+/**
+ * A kiválasztott kernelre mutató pointer.
+ * Kezdetben egy feloldó függvényre mutat, ami az első hívásnál kiválasztja a legjobb kernelt és lecseréli magát,
+ * így statikus inicializálás közben is biztonságosan hívható.
+ */
+extern sha256_compress_fn sha256_compress;
+/**
+ * Visszadja a kiválasztott kernel nevét ("scalar" vagy "shani").
+ * @return const char*.
+ */
+const char* sha256_kernel_name();
+#endif
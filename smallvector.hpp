@@ -0,0 +1,169 @@
+#ifndef SMALLVECTOR
+#define SMALLVECTOR
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "vector.hpp"
+/**
+ * @file smallvector.hpp
+ * A SmallVector generikus tároló osztály header fájlja.
+ */
+
+/**
+ * Generikus tároló osztály belső (inline) tárolóval.
+ * Ugyanazt a felületet adja, mint a Vector, de az első N elemet magában az objektumban tárolja,
+ * és csak N elem fölött foglal dinamikusan memóriát. A rövid életű, tipikusan kicsi ideiglenes bufferek
+ * (pl. a titkosítók segédtömbjei) így nem hívják az allokátort.
+ * Az elemek kezelése, a nyújtás és az iterátorok a Vector-ral közösek (VectorBase), itt csak a memória foglalása és a belső tároló.
+ */
+template<typename T, size_t N>
+class SmallVector: public VectorBase<T, SmallVector<T, N>>{
+  static_assert(N > 0, "SmallVector: N legalabb 1 kell legyen");
+  typedef VectorBase<T, SmallVector<T, N>> Base;
+  friend Base;
+  using Base::elems;
+  using Base::cap;
+  using Base::realcap;
+  using Base::destroy;
+  using Base::relocate;
+  using Base::construct_to;
+  using Base::copy_from;
+  alignas(T) unsigned char inline_buf[N*sizeof(T)]; /**< a belső tároló, nyers memória N elemnek.*/
+  /**
+   * A belső tároló első eleme.
+   */
+  T* inline_data(){
+    return reinterpret_cast<T*>(inline_buf);
+  }
+  /**
+   * Nyers memória legalább n elemnek: N elemig a belső tároló (ekkor n = N), fölötte dinamikus memória.
+   */
+  T* allocate(size_t& n){
+    if(n <= N){
+      n = N;
+      return inline_data();
+    }
+    return static_cast<T*>(::operator new(n*sizeof(T)));
+  }
+  /**
+   * Felszabadítja a dinamikus memóriát; a belső tárolóra nem csinál semmit.
+   */
+  void deallocate(T* p){
+    if(p != inline_data()) ::operator delete(p);
+  }
+  /**
+   * Átveszi a másik tároló tartalmát; a saját tároló üres és belső kell legyen.
+   * Dinamikus memóriánál a pointert veszi át, belső tárolónál az elemeket helyezi át.
+   * Az áthelyezés csak akkor nem dobhat kivételt, ha T mozgató konstruktora sem; egyébként másol, és kivételnél a másik tároló érintetlen.
+   */
+  void steal(SmallVector& other) noexcept(std::is_nothrow_move_constructible<T>::value){
+    if(other.is_small()){
+      relocate(other.elems, other.cap, elems);
+    }
+    else{
+      elems = other.elems;
+      realcap = other.realcap;
+      other.elems = other.inline_data();
+      other.realcap = N;
+    }
+    cap = other.cap;
+    other.cap = 0;
+  }
+public:
+  /**
+   * Konstruktor.
+   * Létrehoz size darab alapértelmezett inicializálású elemet; N elemig a belső tárolóban.
+   * @param size a tömb mérete.
+   */
+  SmallVector(size_t size = 0){
+    realcap = size;
+    elems = allocate(realcap);
+    try{
+      construct_to(size, false);
+    }
+    catch(...){
+      deallocate(elems);
+      throw;
+    }
+    cap = size;
+  }
+  /**
+   * Létrehoz egy size méretű tárolót inicializálás nélkül, csak triviális típusokra, lásd Vector::for_overwrite.
+   * @param size a tömb mérete.
+   * @return SmallVector.
+   */
+  static SmallVector for_overwrite(size_t size){
+    SmallVector res;
+    res.resize_uninitialized(size);
+    return res;
+  }
+  /**
+   * Másoló konstruktor.
+   * @param other a másik SmallVector típusú tároló.
+   */
+  SmallVector(const SmallVector& other){
+    realcap = other.cap;
+    elems = allocate(realcap);
+    try{
+      copy_from(other.elems, other.cap);
+    }
+    catch(...){
+      deallocate(elems);
+      throw;
+    }
+  }
+  /**
+   * Mozgató konstruktor.
+   * Dinamikus memóriát másolás nélkül vesz át, belső tárolónál az elemeket mozgatja. A másik tároló üres marad.
+   * @param other a másik SmallVector típusú tároló.
+   */
+  SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value){
+    elems = inline_data();
+    realcap = N;
+    steal(other);
+  }
+  /**
+   * Értékadó operátor.
+   * @param other a másik SmallVector típusú tároló.
+   * @return SmallVector& referencia tehát használható balértékként.
+   */
+  SmallVector& operator=(const SmallVector& other){
+    if(&other != this){
+      *this = SmallVector(other);
+    }
+    return *this;
+  }
+  /**
+   * Mozgató értékadó operátor.
+   * @param other a másik SmallVector típusú tároló.
+   * @return SmallVector& referencia tehát használható balértékként.
+   */
+  SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value){
+    if(&other != this){
+      destroy(elems, elems + cap);
+      deallocate(elems);
+      elems = inline_data();
+      cap = 0;
+      realcap = N;
+      steal(other);
+    }
+    return *this;
+  }
+  /**
+   * Igaz, ha az elemek a belső tárolóban vannak, azaz nem történt dinamikus foglalás.
+   * @return bool.
+   */
+  bool is_small() const{
+    return elems == reinterpret_cast<const T*>(inline_buf);
+  }
+  /**
+   * Destruktor.
+   * Megszünteti az elemeket, és felszabadítja a dinamikus memóriát, ha van.
+   */
+  ~SmallVector(){
+    destroy(elems, elems + cap);
+    deallocate(elems);
+  }
+};
+#endif // !SMALLVECTOR
@@ -0,0 +1,104 @@
+#ifndef SPAN
+#define SPAN
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+/**
+ * @file span.hpp
+ * A Span generikus tömb nézet header fájlja.
+ */
+
+/**
+ * Nem birtokló nézet egy folytonos T típusú tömbre: egy pointer és egy elemszám.
+ * Az std::span mintájára; a Vector és a nyers bufferek közös, ellenőrzés nélküli elérése a forró ciklusokhoz.
+ * Nem foglal és nem másol, a mutatott tömbnek a nézetnél tovább kell élnie.
+ * Span<const T> csak olvasható nézet, Span<T> automatikusan konvertálódik rá.
+ */
+template<typename T>
+class Span{
+  T* ptr; /**< a nézet első elemére mutat.*/
+  size_t len; /**< a nézet elemszáma.*/
+public:
+  typedef T* iterator; /**< a nézet iterátora egy sima pointer, így minden <algorithm> függvénnyel használható.*/
+  /**
+   * Paraméter nélküli konstruktor, üres nézet.
+   */
+  constexpr Span(): ptr(NULL), len(0){}
+  /**
+   * Konstruktor.
+   * @param ptr az első elem címe.
+   * @param len az elemek száma.
+   */
+  constexpr Span(T* ptr, size_t len): ptr(ptr), len(len){}
+  /**
+   * Konverzió Span<U>-ról Span<T>-re, ha a pointer konverzió biztonságos (pl. Span<uint8_t> -> Span<const uint8_t>).
+   * @param other a másik nézet.
+   */
+  template<typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+  constexpr Span(const Span<U>& other): ptr(other.data()), len(other.size()){}
+  /**
+   * Visszaadja az első elem címét.
+   * @return T*.
+   */
+  constexpr T* data() const{
+    return ptr;
+  }
+  /**
+   * Visszaadja a nézet elemszámát.
+   * @return size_t.
+   */
+  constexpr size_t size() const{
+    return len;
+  }
+  /**
+   * Igaz, ha a nézet üres.
+   * @return bool.
+   */
+  constexpr bool empty() const{
+    return len == 0;
+  }
+  /**
+   * Indexelő operátor, ellenőrzés nélkül.
+   * @param idx index, 0..size()-1.
+   * @return T&.
+   */
+  constexpr T& operator[](size_t idx) const{
+    return ptr[idx];
+  }
+  /**
+   * Ellenőrzött indexelés.
+   * Ha az index a nézet tartományán kívül esik, std::out_of_range kivételt dob.
+   * @param idx az adott index.
+   * @return T&.
+   */
+  T& at(size_t idx) const{
+    if(idx >= len) throw std::out_of_range("Az index a span határain kívül esik!");
+    return ptr[idx];
+  }
+  /**
+   * Az első elemre mutató iterátor.
+   */
+  constexpr iterator begin() const{
+    return ptr;
+  }
+  /**
+   * Az utolsó utáni elemre mutató iterátor.
+   */
+  constexpr iterator end() const{
+    return ptr + len;
+  }
+  /**
+   * Rész nézet, másolás nélkül.
+   * A tartományt a nézet határaira vágja.
+   * @param from a kezdő index.
+   * @param n az elemszám.
+   * @return Span.
+   */
+  Span sub(size_t from, size_t n = (size_t)-1) const{
+    if(from > len) from = len;
+    if(n > len - from) n = len - from;
+    return Span(ptr + from, n);
+  }
+};
+#endif // !SPAN
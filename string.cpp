@@ -1,117 +1,316 @@
 #include "string.h"
-#include <cmath>
-#include <cstdio>
+#include "ascii.h"
+#include "format.h"
 #include <cctype>
 #include <cstring>
+#if defined(STRING_COW)
+#include <atomic>
+#include <new>
 
+/**
+ * A megosztott buffer fejléce, közvetlenül a karakterek előtt.
+ */
+typedef std::atomic<size_t> refcount_t;
+static refcount_t *refs(char *buf){
+  return reinterpret_cast<refcount_t *>(buf - sizeof(refcount_t));
+}
+#endif
+
+/**
+ * Lefoglal egy cap+1 byte-os dinamikus buffert.
+ * STRING_COW módban a buffer elé kerül a referencia számláló, 1 kezdőértékkel.
+ */
+static char *heap_alloc(size_t cap){
+#if defined(STRING_COW)
+  char *raw = new char[sizeof(refcount_t) + cap + 1];
+  new (raw) refcount_t(1);
+  return raw + sizeof(refcount_t);
+#else
+  return new char[cap + 1];
+#endif
+}
+/**
+ * Elengedi a dinamikus buffert. STRING_COW módban csak az utolsó hivatkozó szabadítja fel.
+ */
+static void heap_release(char *buf){
+#if defined(STRING_COW)
+  refcount_t *r = refs(buf);
+  if(r->fetch_sub(1, std::memory_order_acq_rel) == 1){
+    r->~refcount_t();
+    delete[] (char *)r;
+  }
+#else
+  delete[] buf;
+#endif
+}
+
+void String::alloc(size_t len){
+  if(len <= sso_capacity){
+    data = sso.buf;
+    sso.length = (unsigned char)len;
+  }
+  else{
+    data = heap_alloc(len);
+    heap.length = len;
+    heap.cap = len;
+  }
+}
+void String::reallocate(size_t newcap){
+  size_t length = getLength();
+  /**
+   * A belső buffer a dinamikus buffer adatainak helyén van, ezért a hosszt előre kiolvassuk, és csak másolás után írjuk be.
+   */
+  if(newcap <= sso_capacity){
+    if(!is_small()){
+      char *old = data;
+      memcpy(sso.buf, old, length);
+      sso.buf[length] = '\0';
+      sso.length = (unsigned char)length;
+      data = sso.buf;
+      heap_release(old);
+    }
+  }
+  else{
+    char *tmp = heap_alloc(newcap);
+    memcpy(tmp, data, length);
+    tmp[length] = '\0';
+    if(!is_small()) heap_release(data);
+    data = tmp;
+    heap.length = length;
+    heap.cap = newcap;
+  }
+}
+#if defined(STRING_COW)
+void String::detach(){
+  if(refs(data)->load(std::memory_order_acquire) != 1){
+    char *tmp = heap_alloc(heap.cap);
+    memcpy(tmp, data, heap.length+1);
+    heap_release(data);
+    data = tmp;
+  }
+}
+#endif
 String::String(){
-  data= new char[1];
+  alloc(0);
   data[0] = '\0';
-  length = 0;
-  pos = 0;
 }
 String::String(const char *_data){
-  length = strlen(_data);
-  pos = 0;
-  data= new char[length+1];
-  strcpy(data,_data);;
+  size_t len = strlen(_data);
+  alloc(len);
+  memcpy(data, _data, len+1);
+}
+String::String(const char *str, size_t len){
+  alloc(len);
+  memcpy(data, str, len);
+  data[len] = '\0';
+}
+String::String(const StringView& view){
+  size_t len = view.getLength();
+  alloc(len);
+  memcpy(data, view.data(), len);
+  data[len] = '\0';
 }
 String::String(const char c){
-  length = 1;
-  pos= 0;
-  data = new char[length+1];
+  alloc(1);
   data[0] = c;
   data[1] = '\0';
 }
 String::String(const String& rhs){
-  length = rhs.length;
-  data = new char[length+1];
-  pos = rhs.pos;
-  strcpy(data,rhs.data); 
+#if defined(STRING_COW)
+  if(!rhs.is_small()){
+    refs(rhs.data)->fetch_add(1, std::memory_order_relaxed);
+    data = rhs.data;
+    heap = rhs.heap;
+    return;
+  }
+#endif
+  size_t len = rhs.getLength();
+  alloc(len);
+  memcpy(data, rhs.data, len+1);
+}
+String::String(String&& rhs) noexcept{
+  if(rhs.is_small()){
+    sso = rhs.sso;
+    data = sso.buf;
+  }
+  else{
+    heap = rhs.heap;
+    data = rhs.data;
+  }
+  rhs.data = rhs.sso.buf;
+  rhs.sso.buf[0] = '\0';
+  rhs.sso.length = 0;
 }
 String::String(const int a){
-  length = int(log10(a)) + 1;
-  pos = 0;
-  data = new char[length+1];
-  sprintf(data, "%d", a);
+  char tmp[int_max_digits];
+  size_t len = format_int(tmp, a);
+  alloc(len);
+  memcpy(data, tmp, len);
+  data[len] = '\0';
 }
 String::String(const uint32_t a){
-  length = 8;
-  pos = 0;
-  data = new char[length+1];
-  sprintf(data, "%08x", a);
+  alloc(8);
+  format_hex32(data, a);
+  data[8] = '\0';
 }
 String String::operator+(const String& rhs) const{
+  size_t length = getLength();
   String res;
-  delete[] res.data;
-  res.length = length + rhs.length; 
-  res.data = new char[res.length+1];
-  strcpy(res.data, data);
-  strcat(res.data, rhs.data);
+  res.alloc(length + rhs.getLength());
+  memcpy(res.data, data, length);
+  memcpy(res.data + length, rhs.data, rhs.getLength()+1);
   return res;
 }
 
 String& String::operator=(const String& rhs){
   if(&rhs != this){
-    delete[] data;
-    length = rhs.length;
-    data = new char[length+1];
-    strcpy(data, rhs.data);
+#if defined(STRING_COW)
+    /**
+     * A saját buffert nem írjuk felül, mert lehet megosztott: elengedjük, és a hosszú rhs bufferét megosztjuk.
+     */
+    if(!is_small()){
+      heap_release(data);
+      data = sso.buf;
+    }
+    if(!rhs.is_small()){
+      refs(rhs.data)->fetch_add(1, std::memory_order_relaxed);
+      data = rhs.data;
+      heap = rhs.heap;
+      return *this;
+    }
+#endif
+    size_t len = rhs.getLength();
+    if(len > getCapacity()){
+      if(!is_small()) heap_release(data);
+      alloc(len);
+    }
+    setLength(len);
+    memcpy(data, rhs.data, len+1);
+  }
+  return *this;
+}
+String& String::operator=(String&& rhs) noexcept{
+  if(&rhs != this){
+    if(!is_small()) heap_release(data);
+    if(rhs.is_small()){
+      sso = rhs.sso;
+      data = sso.buf;
+    }
+    else{
+      heap = rhs.heap;
+      data = rhs.data;
+    }
+    rhs.data = rhs.sso.buf;
+    rhs.sso.buf[0] = '\0';
+    rhs.sso.length = 0;
   }
   return *this;
 }
+String& String::append(const char *str, size_t len){
+  unshare();
+  size_t length = getLength();
+  if(length + len > getCapacity()){
+    /**
+     * str a saját bufferünkbe is mutathat (s += s), ezért az áthelyezés előtt megjegyezzük a helyét.
+     */
+    bool self = str >= data && str <= data + length;
+    size_t off = self ? (size_t)(str - data) : 0;
+    grow(length + len);
+    if(self) str = data + off;
+  }
+  memmove(data + length, str, len);
+  data[length + len] = '\0';
+  setLength(length + len);
+  return *this;
+}
 bool String::operator&(const String& other) const{
-  return strcmp(data, other.data) == 0;
+  size_t length = getLength();
+  return length == other.getLength() && memcmp(data, other.data, length) == 0;
 }
 bool String::operator==(char c) const{
-  return strchr(data, c);
-}
-String String::substr(const char sep){
- String res;
- size_t i = pos;
- while(i < length && (*this)[i] != sep && (*this)[i] != '\n'){
-  res+=(*this)[i++];
- }
- while( i < length && ((*this)[i] == sep || (*this)[i] == '\n')){
-  i++;
- }
- pos = i;
- return res;
-}
-size_t String::getPos() const{
-  return pos;
+  return memchr(data, c, getLength()) != NULL;
 }
 bool String::isalpha() const{
-  for(size_t i = 0; i < length; ++i){
-    if(!std::isalpha(data[i])) return false;
-  }
-  return true;
+  return ascii_isalpha(data, getLength());
 }
 void String::toUpper(){
-  for(size_t i = 0; i < length; ++i){
-    if(std::isalpha(data[i])) data[i] = std::toupper(data[i]); 
-  }
+  unshare();
+  ascii_toupper(data, getLength());
 }
 void String::toLower(){
-  for(size_t i = 0; i < length; ++i){
-    if(std::isalpha(data[i])) data[i] = std::tolower(data[i]); 
-  }
+  unshare();
+  ascii_tolower(data, getLength());
+}
+bool String::toUpperAlpha(){
+  unshare();
+  return ascii_upper_alpha(data, getLength(), data);
 }
 String::~String(){
-  delete[] data;
+  if(!is_small()) heap_release(data);
 }
 std::ostream& operator<<(std::ostream& os, const String& rhs){
-  return (os << rhs.c_string());
+  return os.write(rhs.c_string(), rhs.getLength());
+}
+/**
+ * A stream bufferéből olvas, amíg stop(c) hamis nem lesz vagy a stream véget nem ér.
+ * A karaktereket sgetc/snextc-vel olvassa (ez a buffer belsejében csak egy pointer léptetés),
+ * és 256-os darabokban fűzi out-hoz, így a String nem karakterenként nő. A megállító karaktert nem veszi ki.
+ * @return size_t a beolvasott karakterek száma.
+ */
+template<typename Stop>
+static size_t read_until(std::streambuf* sb, String& out, Stop stop, bool& eof){
+  typedef std::char_traits<char> traits;
+  char chunk[256];
+  size_t n = 0;
+  size_t total = 0;
+  traits::int_type c = sb->sgetc();
+  for(;;){
+    if(traits::eq_int_type(c, traits::eof())){
+      eof = true;
+      break;
+    }
+    char ch = traits::to_char_type(c);
+    if(stop(ch)) break;
+    chunk[n++] = ch;
+    if(n == sizeof(chunk)){
+      out.append(chunk, n);
+      total += n;
+      n = 0;
+    }
+    c = sb->snextc();
+  }
+  out.append(chunk, n);
+  return total + n;
 }
 std::istream& operator>>(std::istream& is, String& rhs){
-  char c = '\0';
-  String res;
-  while(is.get(c) && isspace(c)){}
-  res+=c;
-  while(is.get(c) && !isspace(c) && c !='\n'){
-    res+=c;
+  std::istream::sentry ok(is);
+  if(!ok) return is;
+  bool eof = false;
+  rhs.clear();
+  /**
+   * A C locale whitespace karakterei: szóköz, \t, \n, \v, \f, \r.
+   */
+  size_t n = read_until(is.rdbuf(), rhs, [](char c){ return c == ' ' || (c >= '\t' && c <= '\r'); }, eof);
+  std::ios_base::iostate state = std::ios_base::goodbit;
+  if(eof) state |= std::ios_base::eofbit;
+  if(n == 0) state |= std::ios_base::failbit;
+  if(state != std::ios_base::goodbit) is.setstate(state);
+  return is;
+}
+std::istream& getline(std::istream& is, String& line, char delim){
+  std::istream::sentry ok(is, true);
+  if(!ok) return is;
+  bool eof = false;
+  line.clear();
+  size_t n = read_until(is.rdbuf(), line, [delim](char c){ return c == delim; }, eof);
+  std::ios_base::iostate state = std::ios_base::goodbit;
+  if(eof){
+    state |= std::ios_base::eofbit;
+    if(n == 0) state |= std::ios_base::failbit;
   }
-  rhs = res;
+  else{
+    is.rdbuf()->sbumpc();
+  }
+  if(state != std::ios_base::goodbit) is.setstate(state);
   return is;
 }
-
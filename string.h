@@ -6,6 +6,8 @@
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
+#include "stringview.h"
 
 /**
  * @file string.h.
@@ -15,11 +17,90 @@
 /**
  * String osztály, ami követi az std::string mintáját.
  * A szövegkezelésért felelős osztály, ami lehetővé teszi a szövegekkel való műveleteket.
+ * A legfeljebb sso_capacity hosszú szövegeket a példányon belül tárolja (small-string optimization),
+ * így a rövid felhasználónevek, sók és kulcsok létrehozása és másolása nem foglal dinamikus memóriát.
+ * A belső buffer ugyanazon a helyen van, mint a dinamikus buffer hossza és kapacitása (union), így a String csak egy pointerrel
+ * nagyobb, mint a belső buffer; hogy melyik él, azt a data == sso.buf dönti el.
+ * A műveletek a length alapján dolgoznak (memcpy, memcmp), így a String bináris adatot, beágyazott '\0' byte-okat is tárolhat.
+ *
+ * Ha a programot STRING_COW makróval fordítjuk (minden fordítási egységet!), a dinamikus bufferek megosztottak:
+ * a buffer elején egy atomi referencia számláló áll, a másolás csak ezt növeli, és a buffer csak az első módosításkor másolódik le
+ * (copy-on-write). Ez a sok, ugyanazt a kulcsot vagy sót másoló objektum memóriáját takarítja meg.
+ * Ebben a módban a nem konstans operator[] is lemásolja a megosztott buffert, és a visszaadott referencia csak a következő másolásig érvényes.
  */
 class String{
-  char *data; /**< karakter pointer ami egy karakter tömbre mutat, aminek a végét '\0' jelzi.*/
-  size_t length; /**< a String hossza, a lezáró karaktert nem beleértve.*/
-  size_t pos; /**< a substr kihasználja mint mutató.*/
+  public:
+  static const size_t sso_capacity = 22; /**< a példányon belül tárolható leghosszabb szöveg hossza.*/
+  private:
+  /**
+   * A dinamikus buffer adatai.
+   */
+  struct Heap{
+    size_t length; /**< a String hossza, a lezáró karaktert nem beleértve.*/
+    size_t cap; /**< a buffer kapacitása, a lezáró karaktert nem beleértve (a buffer cap+1 byte-os).*/
+  };
+  /**
+   * A rövid szövegek helyben tárolt buffere.
+   */
+  struct Small{
+    char buf[sso_capacity + 1]; /**< a szöveg, a lezáró '\0'-val együtt.*/
+    unsigned char length; /**< a String hossza, legfeljebb sso_capacity.*/
+  };
+  char *data; /**< karakter pointer ami egy getLength() hosszú karakter tömbre mutat, ami után mindig áll egy lezáró '\0'. Rövid szövegnél az sso.buf-ra mutat.*/
+  union{
+    Heap heap; /**< dinamikus buffernél érvényes.*/
+    Small sso; /**< rövid szövegnél érvényes.*/
+  };
+  /**
+   * Beállítja a hosszt, a buffer fajtájának megfelelő helyen. A lezáró '\0'-t nem írja.
+   * @param len az új hossz, legfeljebb getCapacity().
+   */
+  void setLength(size_t len){
+    if(is_small()) sso.length = (unsigned char)len;
+    else heap.length = len;
+  }
+  /**
+   * Beállítja a hosszt, és len hosszú szövegnek helyet választ: a belső buffert, vagy ha nem fér bele, dinamikusan foglal.
+   * A korábbi buffert nem szabadítja fel.
+   * @param len a szöveg hossza.
+   */
+  void alloc(size_t len);
+  /**
+   * Pontosan newcap kapacitású bufferbe költözteti a szöveget (length byte-ot másol), a régi dinamikus buffert felszabadítja.
+   * @param newcap az új kapacitás, legalább length.
+   */
+  void reallocate(size_t newcap);
+  /**
+   * Geometrikusan (legalább duplájára) növeli a kapacitást, hogy needed hosszú szöveg elférjen.
+   * Így n darab hozzáfűzés összesen O(n) másolással jár.
+   * @param needed a szükséges kapacitás.
+   */
+  void grow(size_t needed){
+    size_t cap = getCapacity();
+    reallocate(needed > 2*cap ? needed : 2*cap);
+  }
+  friend class StringBuilder;
+  /**
+   * Igaz, ha a szöveg a belső bufferben van.
+   * @return bool.
+   */
+  bool is_small() const{
+    return data == sso.buf;
+  }
+#if defined(STRING_COW)
+  /**
+   * Ha a dinamikus buffert más String is használja, saját másolatot készít róla.
+   */
+  void detach();
+#endif
+  /**
+   * Írás előtt hívandó. STRING_COW módban a megosztott buffert lemásolja, egyébként nem csinál semmit.
+   */
+  void unshare(){
+#if defined(STRING_COW)
+    if(!is_small()) detach();
+#endif
+  }
   public:
   /**
    * Konstruktor.
@@ -27,6 +108,19 @@ class String{
    * @param karakter tömb.
    */
   String(const char  *);
+  /**
+   * Konstruktor.
+   * A Stringet az adott karaktertömb első len elemével inicializálja.
+   * @param str karakter tömb.
+   * @param len a másolandó karakterek száma.
+   */
+  String(const char *str, size_t len);
+  /**
+   * Konstruktor.
+   * A nézet tartalmát a Stringbe másolja.
+   * @param view a másolandó nézet.
+   */
+  explicit String(const StringView& view);
   /**
    * Paraméter nélüli konstruktor.
    * A Stringet 0 mérettel, egy '\0' karakterrel inicializálja. 
@@ -43,9 +137,16 @@ class String{
    * @param egy másik String objektum.
    */
   String(const String&);
+  /**
+   * Mozgató konstruktor.
+   * Dinamikus buffer esetén átveszi a pointert másolás nélkül, a forrás üres String marad.
+   * @param egy másik String objektum, amit már nem használunk.
+   */
+  String(String&&) noexcept;
   /**
    * Konstruktor.
    * A Stringet inicializálja az adott int szám alaki értékeinek számjegyeivel pl. a (int)100-ból "100"-at csinál.
+   * A 0-t és a negatív számokat is kezeli, pl. (int)-7-ből "-7" lesz.
    * @param integer szám.
    */
   String(const int);
@@ -67,10 +168,33 @@ class String{
    * @return const size_t.
    */
   const size_t getLength() const{
-    return length;
+    return is_small() ? sso.length : heap.length;
+  }
+  /**
+   * Visszadja, hány karakter fér el a bufferben újrafoglalás nélkül.
+   * @return size_t.
+   */
+  size_t getCapacity() const{
+    return is_small() ? sso_capacity : heap.cap;
+  }
+  /**
+   * Kiüríti a Stringet, a buffert és a kapacitást megtartja.
+   */
+  void clear(){
+    unshare();
+    setLength(0);
+    data[0] = '\0';
+  }
+  /**
+   * Legalább n karakternyi helyet foglal, hogy a további hozzáfűzések ne foglaljanak újra.
+   * @param n a kívánt kapacitás.
+   */
+  void reserve(size_t n){
+    if(n > getCapacity()) reallocate(n);
   }
   /**
    * Visszadja, hogy a tárol szöveg minden karaktere angol abc-beli e.
+   * Locale-független, SIMD-del gyorsított ASCII vizsgálat.
    * @return bool.
    */
   bool isalpha() const;
@@ -100,6 +224,13 @@ class String{
    * @return String& String referencia, tehát használható a balértékként is.
    */
   String& operator=(const String&);
+  /**
+   * Mozgató értékadó operátor.
+   * Dinamikus buffer esetén átveszi a pointert másolás nélkül, a forrás üres String marad.
+   * @param rhs a példány új értéke, amit már nem használunk.
+   * @return String& String referencia.
+   */
+  String& operator=(String&& rhs) noexcept;
   /**
    * Értékadó operátor.
    * A példány eddigi tartalmát tölri, majd újra inicializálja a paraméter értékeivel. Operator overload.
@@ -112,7 +243,45 @@ class String{
   String& operator=(const T& rhs){
     return *this = String(rhs);
   }
-   /**
+  /**
+   * Hozzáfűz len karaktert a példány végéhez.
+   * Ha nem fér el, a kapacitást geometrikusan növeli, így a hozzáfűzés amortizáltan O(len).
+   * @param str a hozzáfűzendő karakterek.
+   * @param len a karakterek száma.
+   * @return String& String referencia.
+   */
+  String& append(const char *str, size_t len);
+  /**
+   * Hozzáfűző + operátor Stringre.
+   * @param rhs a hozzáfűzendő String.
+   * @return String& String referencia.
+   */
+  String& operator+=(const String& rhs){
+    return append(rhs.data, rhs.getLength());
+  }
+  /**
+   * Hozzáfűző + operátor C-sztringre.
+   * @param rhs a hozzáfűzendő karaktertömb.
+   * @return String& String referencia.
+   */
+  String& operator+=(const char *rhs){
+    return append(rhs, strlen(rhs));
+  }
+  /**
+   * Hozzáfűző + operátor egy karakterre, amortizáltan O(1).
+   * @param c a hozzáfűzendő karakter.
+   * @return String& String referencia.
+   */
+  String& operator+=(char c){
+    unshare();
+    size_t length = getLength();
+    if(length == getCapacity()) grow(length + 1);
+    data[length] = c;
+    data[length + 1] = '\0';
+    setLength(length + 1);
+    return *this;
+  }
+  /**
    * Hozzáfűző + operátor.
    * A példányhoz hozzáfűzi a paraméterként kapott másik T típusú változót.
    * Csak azokra a T típusokra működik amikre implementálva van a T->String konverzió (const char*, char, int, uint32_t).
@@ -122,7 +291,7 @@ class String{
    */
   template<typename T>
   String& operator+=(const T& rhs){
-    return *this = *this + rhs;
+    return *this += String(rhs);
   }
   /**
    * Indexelű operátor.
@@ -131,8 +300,9 @@ class String{
    * @return char& referencia tehát használható balértékként.
    */
   char& operator[](size_t idx){
-    if(idx < 0 || idx >= length) throw std::out_of_range("Az index a sztring határain kívül esik!");
+    if(idx < 0 || idx >= getLength()) throw std::out_of_range("Az index a sztring határain kívül esik!");
     else{
+      unshare();
       return data[idx];
     }
   }
@@ -143,14 +313,14 @@ class String{
    * @return const char& referencia.
    */
   const char& operator[](size_t idx) const{
-    if(idx < 0 || idx >= length) throw std::out_of_range("Az index a sztring határain kívül esik!");
+    if(idx < 0 || idx >= getLength()) throw std::out_of_range("Az index a sztring határain kívül esik!");
     else{
       return data[idx];
     }
   }
   /**
    * Összehasonlító operátor.
-   * Összehasonlítja a példányt egy másik Stringgel, és ez szerint visszatér egy bool-lal.
+   * Összehasonlítja a példányt egy másik Stringgel (hossz és byte-ok alapján), és ez szerint visszatér egy bool-lal.
    * @param rhs amivel összehasonlítunk.
    * @return bool az összehasonlítás logikai értéke.
    */
@@ -163,38 +333,151 @@ class String{
    */
   bool operator==(char) const;
   /**
-   * Rész stringet készít.
-   * Az adott karakterig vagy az EOF-ig kimásol egy rész stringet.
-   * Változtatja a pos változót, hogy a következő substr hívásnál már a következő rész stringet adja vissza.
-   * @param sep szeparátor karakter.
-   * @return String.
+   * Nem birtokló nézet a String tartalmára.
+   * A nézet addig érvényes, amíg a String él és nem módosul.
+   * @return StringView.
    */
-  String substr(const char );
+  operator StringView() const{
+    return StringView(data, getLength());
+  }
   /**
-   * Visszadja pos értékét.
+   * Allokációmentesen darabolja a szöveget a sep és '\n' karaktereknél.
+   * A darabok a String bufferére mutatnak, ezért a String-nek túl kell élnie a darabolást.
+   * @param sep szeparátor karakter.
+   * @return StringSplit.
    */
-  size_t getPos() const;
+  StringSplit split(char sep) const{
+    return StringSplit(*this, sep);
+  }
   /**
    * A szöveg összes abc-beli katarkterét nagy betűre cseréli.
    */
   void toUpper();
+  /**
+   * Egy menetben ellenőrzi, hogy minden karakter az angol abc betűje-e, és nagybetűsít.
+   * Hamis visszatérési érték esetén a tartalom részben nagybetűsített lehet.
+   * @return bool igaz, ha minden karakter betű.
+   */
+  bool toUpperAlpha();
     /**
    * A szöveg összes abc-beli katarkterét kis betűre cseréli.
    */
   void toLower();
   /**
    * Destruktor.
-   * Fölszabadítja a dinamikusan foglalt karaktertömböt.
+   * Fölszabadítja a dinamikusan foglalt karaktertömböt, ha van.
    */
   ~String();
 };
+static_assert(sizeof(String) == sizeof(char *) + String::sso_capacity + 2, "A String belso buffere a hossz es kapacitas helyen kell legyen");
+/**
+ * Szöveg építésére szolgáló osztály.
+ * Karaktereket és karaktersorozatokat fűz egy bufferhez amortizáltan O(1) időben (karakterenként),
+ * a lezáró '\0'-t csak a str() híváskor írja ki, a kész Stringet pedig másolás nélkül adja át.
+ */
+class StringBuilder{
+  String buf; /**< az épülő szöveg, lezáró '\0' nélkül. STRING_COW módban a builder másolata ezt megoszthatja, ezért írás előtt unshare().*/
+  public:
+  /**
+   * Konstruktor.
+   * @param n ennyi karakternek előre foglal helyet, ha ismert a végső hossz.
+   */
+  explicit StringBuilder(size_t n = 0){
+    buf.reserve(n);
+  }
+  /**
+   * Előre foglal helyet legalább n karakternek.
+   * @param n a kívánt kapacitás.
+   */
+  void reserve(size_t n){
+    buf.reserve(n);
+  }
+  /**
+   * Visszaadja az eddig hozzáfűzött karakterek számát.
+   * @return size_t.
+   */
+  size_t getLength() const{
+    return buf.getLength();
+  }
+  /**
+   * Hozzáfűz egy karaktert.
+   * @param c a karakter.
+   * @return StringBuilder& referencia, így a hívások láncolhatók.
+   */
+  StringBuilder& append(char c){
+    size_t length = buf.getLength();
+    if(length == buf.getCapacity()) buf.grow(length + 1);
+    else buf.unshare();
+    buf.data[length] = c;
+    buf.setLength(length + 1);
+    return *this;
+  }
+  /**
+   * Hozzáfűz len karaktert.
+   * @param str a karakterek.
+   * @param len a karakterek száma.
+   * @return StringBuilder& referencia.
+   */
+  StringBuilder& append(const char *str, size_t len){
+    size_t length = buf.getLength();
+    if(length + len > buf.getCapacity()) buf.grow(length + len);
+    else buf.unshare();
+    memcpy(buf.data + length, str, len);
+    buf.setLength(length + len);
+    return *this;
+  }
+  /**
+   * Hozzáfűz n inicializálatlan karaktert, és visszaadja az első címét, hogy a hívó közvetlenül oda írjon.
+   * A pointer a következő hozzáfűzésig érvényes.
+   * @param n a karakterek száma.
+   * @return char* az új karakterek kezdőcíme.
+   */
+  char *append_uninitialized(size_t n){
+    size_t length = buf.getLength();
+    if(length + n > buf.getCapacity()) buf.grow(length + n);
+    else buf.unshare();
+    char *p = buf.data + length;
+    buf.setLength(length + n);
+    return p;
+  }
+  /**
+   * Hozzáfűz egy Stringet.
+   * @param str a String.
+   * @return StringBuilder& referencia.
+   */
+  StringBuilder& append(const String& str){
+    return append(str.c_string(), str.getLength());
+  }
+  /**
+   * Lezárja és átadja a felépített Stringet, a builder utána üres.
+   * @return String.
+   */
+  String str(){
+    buf.unshare();
+    buf.data[buf.getLength()] = '\0';
+    return std::move(buf);
+  }
+};
 /**
  * Globális inserter operátor.
+ * A teljes, length hosszú tartalmat kiírja, a beágyazott '\0' byte-okat is.
  */
 std::ostream& operator<<(std::ostream& os, const String& rhs);
 /**
  * Globális extractor operátor.
- * A whitespace-ket figyelmen kivűl hagyja.
+ * A szó eleji whitespace-ket eldobja, majd a következő whitespace-ig olvas, mint a scanf %s.
+ * A stream bufferéből darabokban olvas, és rhs meglévő bufferét újrahasználja.
+ * Ha nem olvasott be semmit, failbit-et állít és rhs-t nem módosítja.
  */
 std::istream& operator>>(std::istream& is, String& rhs);
+/**
+ * Beolvas egy sort (a delim karakterig, azt kiveszi a streamből, de nem tárolja).
+ * A line meglévő bufferét újrahasználja, így egy nagy fájl soronkénti olvasásakor a buffer csak a leghosszabb sorig nő.
+ * Ha a stream végén egy karaktert sem olvasott, failbit-et állít, mint az std::getline.
+ * @param is a bemeneti stream.
+ * @param line ide kerül a sor.
+ * @param delim a sor vége karakter.
+ * @return std::istream& a stream, így while(getline(is, line)) ciklusban használható.
+ */
+std::istream& getline(std::istream& is, String& line, char delim = '\n');
 #endif // !STRING
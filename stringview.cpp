@@ -0,0 +1,28 @@
+#include "stringview.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const char *find_separator(const char *begin, const char *end, char sep){
+  if(sep == '\n'){
+    const void *p = memchr(begin, '\n', (size_t)(end - begin));
+    return p == NULL ? end : (const char *)p;
+  }
+  const char *p = begin;
+#if defined(__SSE2__)
+  /**
+   * 16 byte-onként összehasonlítjuk mindkét szeparátorral, a találatok bitmaszkjának legalsó bitje az első találat.
+   */
+  const __m128i s = _mm_set1_epi8(sep);
+  const __m128i nl = _mm_set1_epi8('\n');
+  for(; end - p >= 16; p += 16){
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, s), _mm_cmpeq_epi8(v, nl)));
+    if(mask != 0) return p + __builtin_ctz((unsigned)mask);
+  }
+#endif
+  for(; p < end; ++p){
+    if(*p == sep || *p == '\n') return p;
+  }
+  return end;
+}
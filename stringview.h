@@ -0,0 +1,236 @@
+#ifndef STRINGVIEW
+#define STRINGVIEW
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @file stringview.h
+ * A StringView és a StringSplit osztályok header fájlja.
+ */
+
+/**
+ * Nem birtokló szöveg nézet: egy pointer és egy hossz.
+ * Nem foglal és nem másol, a mutatott buffernek a nézetnél tovább kell élnie.
+ * Nem feltétlenül '\0'-val lezárt, ezért mindig a hosszal együtt kell használni.
+ */
+class StringView{
+  const char *ptr; /**< a nézet első karakterére mutat.*/
+  size_t len; /**< a nézet hossza.*/
+  public:
+  static constexpr size_t npos = (size_t)-1; /**< a find visszatérési értéke, ha nincs találat.*/
+  /**
+   * Paraméter nélküli konstruktor, üres nézet.
+   */
+  constexpr StringView(): ptr(""), len(0){}
+  /**
+   * Konstruktor.
+   * @param str a karakterek kezdőcíme.
+   * @param n a karakterek száma.
+   */
+  constexpr StringView(const char *str, size_t n): ptr(str), len(n){}
+  /**
+   * Konstruktor '\0'-val lezárt karaktertömbből.
+   * @param str karakter tömb.
+   */
+  StringView(const char *str): ptr(str), len(strlen(str)){}
+  /**
+   * Visszaadja a karakterek kezdőcímét.
+   * @return const char*.
+   */
+  constexpr const char *data() const{
+    return ptr;
+  }
+  /**
+   * Visszaadja a nézet hosszát.
+   * @return size_t.
+   */
+  constexpr size_t getLength() const{
+    return len;
+  }
+  /**
+   * Igaz, ha a nézet üres.
+   * @return bool.
+   */
+  constexpr bool empty() const{
+    return len == 0;
+  }
+  /**
+   * Indexelő operátor, ellenőrzés nélkül.
+   * @param idx index, 0..getLength()-1.
+   * @return char.
+   */
+  constexpr char operator[](size_t idx) const{
+    return ptr[idx];
+  }
+  /**
+   * Az első karakterre mutató pointer, a tartomány alapú for ciklushoz.
+   */
+  constexpr const char *begin() const{
+    return ptr;
+  }
+  /**
+   * Az utolsó utáni karakterre mutató pointer.
+   */
+  constexpr const char *end() const{
+    return ptr + len;
+  }
+  /**
+   * Rész nézet, másolás nélkül.
+   * A tartományt a nézet határaira vágja.
+   * @param from a kezdő index.
+   * @param n a hossz.
+   * @return StringView.
+   */
+  StringView sub(size_t from, size_t n = npos) const{
+    if(from > len) from = len;
+    if(n > len - from) n = len - from;
+    return StringView(ptr + from, n);
+  }
+  /**
+   * Megkeresi a c karakter első előfordulását from-tól kezdve (memchr).
+   * @param c a keresett karakter.
+   * @param from a keresés kezdő indexe.
+   * @return size_t a találat indexe, vagy npos.
+   */
+  size_t find(char c, size_t from = 0) const{
+    if(from >= len) return npos;
+    const void *p = memchr(ptr + from, c, len - from);
+    return p == NULL ? npos : (size_t)((const char *)p - ptr);
+  }
+  /**
+   * Összehasonlító operátor, hossz és byte-ok alapján.
+   * @param rhs a másik nézet.
+   * @return bool.
+   */
+  bool operator==(const StringView& rhs) const{
+    return len == rhs.len && memcmp(ptr, rhs.ptr, len) == 0;
+  }
+  /**
+   * Negált összehasonlító operátor.
+   * @param rhs a másik nézet.
+   * @return bool.
+   */
+  bool operator!=(const StringView& rhs) const{
+    return !(*this == rhs);
+  }
+};
+
+/**
+ * Megkeresi az első sep vagy '\n' karaktert a [begin, end) tartományban.
+ * SSE2-vel 16 byte-onként keres, egyébként memchr-rel (ha sep == '\n') vagy bájtonként.
+ * @param begin a tartomány eleje.
+ * @param end a tartomány vége.
+ * @param sep a szeparátor.
+ * @return const char* a találat, vagy end.
+ */
+const char *find_separator(const char *begin, const char *end, char sep);
+
+/**
+ * Allokációmentes daraboló egy nézet felett.
+ * A szöveget sep vagy '\n' karaktereknél darabolja, az egymást követő szeparátorokat egynek veszi,
+ * és az üres darabokat kihagyja. A darabok az eredeti bufferre mutató StringView-k.
+ * Használat:
+ *   for(StringView tok : StringSplit(szoveg, ' ')) ...
+ */
+class StringSplit{
+  StringView text; /**< a darabolt szöveg.*/
+  char sep; /**< a szeparátor; a '\n' mindig szeparátor.*/
+  public:
+  /**
+   * Bemeneti iterátor, ami az aktuális darabot tárolja.
+   */
+  class iterator{
+    StringView tok; /**< az aktuális darab; a vég iterátornál data() == NULL.*/
+    const char *end; /**< a darabolt szöveg vége.*/
+    char sep; /**< a szeparátor.*/
+    /**
+     * A p-től kezdve megkeresi a következő nem üres darabot.
+     */
+    void advance(const char *p){
+      while(p < end && (*p == sep || *p == '\n')) ++p;
+      if(p == end){
+        tok = StringView(NULL, 0);
+        return;
+      }
+      const char *q = find_separator(p, end, sep);
+      tok = StringView(p, (size_t)(q - p));
+    }
+  public:
+    /**
+     * Konstruktor, a vég iterátorhoz paraméter nélkül.
+     */
+    iterator(): tok(NULL, 0), end(NULL), sep('\0'){}
+    /**
+     * Konstruktor, a text első darabjára áll.
+     * @param text a darabolt szöveg.
+     * @param sep a szeparátor.
+     */
+    iterator(const StringView& text, char sep): tok(), end(text.end()), sep(sep){
+      advance(text.begin());
+    }
+    /**
+     * Dereferáló operátor.
+     * @return StringView az aktuális darab.
+     */
+    const StringView& operator*() const{
+      return tok;
+    }
+    /**
+     * Nyíl operátor.
+     */
+    const StringView *operator->() const{
+      return &tok;
+    }
+    /**
+     * Preinkremens operátor, a következő darabra lép.
+     * @return iterator&.
+     */
+    iterator& operator++(){
+      advance(tok.end());
+      return *this;
+    }
+    /**
+     * Posztinkremens operátor, a következő darabra lép.
+     * @return iterator a léptetés előtti állapot.
+     */
+    iterator operator++(int){
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    /**
+     * Összehasonlító operátor: két iterátor egyenlő, ha ugyanarra a darabra mutatnak.
+     */
+    bool operator==(const iterator& other) const{
+      return tok.data() == other.tok.data();
+    }
+    /**
+     * Negált összehasonlító operátor.
+     */
+    bool operator!=(const iterator& other) const{
+      return tok.data() != other.tok.data();
+    }
+  };
+  /**
+   * Konstruktor.
+   * @param text a darabolandó szöveg.
+   * @param sep a szeparátor, a '\n' mellett.
+   */
+  StringSplit(const StringView& text, char sep): text(text), sep(sep){}
+  /**
+   * Az első darabra mutató iterátor.
+   * @return iterator.
+   */
+  iterator begin() const{
+    return iterator(text, sep);
+  }
+  /**
+   * A vég iterátor.
+   * @return iterator.
+   */
+  iterator end() const{
+    return iterator();
+  }
+};
+#endif
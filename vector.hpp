@@ -2,85 +2,267 @@
 #define VECTOR
 
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "span.hpp"
 /**
  * @file vector.hpp
  * A Vector generikus tároló osztály header fájlja.
  */
 
 /**
- * Generikus tároló osztály.
- * Az std::vector szabványát követi, ezzel megvalósítva egy generikus nyújtató tömb osztályt.
+ * Igazítási szabály a Vector tárolóhoz: a tároló memóriája N byte-os határon kezdődik.
+ * Pl. Vector<uint8_t, Align<64>> cache line határra igazított byte tömb, amin a SIMD kernelek igazított betöltéssel dolgozhatnak.
+ * @tparam N az igazítás byte-ban, kettő hatvány.
+ */
+template<size_t N>
+struct Align{
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Align: az igazitas kettő hatvany kell legyen");
+  static constexpr size_t value = N; /**< az igazítás byte-ban.*/
+};
+
+/**
+ * A Vector és a SmallVector közös alaposztálya.
+ * Itt van a nyers (konstruálatlan) tárolás teljes kezelése: elemek létrehozása, áthelyezése, megszüntetése, a nyújtás,
+ * az indexelés és az iterátorok. A memória foglalását és felszabadítását a leszármazott (D) adja (CRTP), két függvénnyel:
+ *   T* allocate(size_t& n): legalább n elemnyi nyers memória; n-et a ténylegesen kapott kapacitásra növelheti.
+ *   void deallocate(T* p): az allocate által adott memória felszabadítása (NULL-ra is hívható).
  */
-template<typename T>
-class Vector{
-  T* data; /**< az adatot tároló memóriára mutató pointer.*/
+template<typename T, typename D>
+class VectorBase{
+protected:
+  T* elems; /**< az adatot tároló memóriára mutató pointer.*/
   size_t cap; /**< a tároló kapacitása.*/
   size_t realcap; /**< a tároló valódi kapacitása, ezt a memória foglalás optimalizálásánál használja.*/
+  /**
+   * Igaz, ha az elemek byte-onként másolhatók és destruktor nélkül eldobhatók (pl. uint8_t, Digest).
+   */
+  static constexpr bool trivial = std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value;
+  /**
+   * Üres tároló; a leszármazott konstruktora állítja be a memóriát.
+   */
+  VectorBase(): elems(NULL), cap(0), realcap(0){}
+  /**
+   * A leszármazott objektum, a foglaló függvényei eléréséhez.
+   */
+  D& self(){
+    return *static_cast<D*>(this);
+  }
+  /**
+   * Megszünteti a [from, to) tartomány elemeit, a memóriát nem szabadítja fel.
+   */
+  static void destroy(T* from, T* to){
+    if(!trivial){
+      for(; from != to; ++from) from->~T();
+    }
+  }
+  /**
+   * Az n elemet from-ból a konstruálatlan to-ba helyezi át, a forrás elemeket megszünteti.
+   * Triviális típusnál egy memcpy, egyébként mozgató konstruálás (ha az nem dobhat kivételt, különben másolás).
+   * Kivétel esetén a cél már létrehozott elemeit megszünteti, a forrás érintetlen marad.
+   */
+  static void relocate(T* from, size_t n, T* to){
+    if(trivial){
+      if(n > 0) memcpy(static_cast<void*>(to), from, n*sizeof(T));
+      return;
+    }
+    size_t i = 0;
+    try{
+      for(; i < n; ++i) ::new(static_cast<void*>(to + i)) T(std::move_if_noexcept(from[i]));
+    }
+    catch(...){
+      destroy(to, to + i);
+      throw;
+    }
+    destroy(from, from + n);
+  }
+  /**
+   * Új, legalább newcap valódi kapacitású memóriát kér a leszármazottól, és áthelyezi bele az elemeket.
+   * Ha a leszármazott ugyanazt a memóriát adja vissza (pl. a SmallVector belső tárolóját), nincs mit áthelyezni.
+   * @param newcap az új valódi kapacitás, legalább cap.
+   */
+  void reallocate(size_t newcap){
+    T* new_data = self().allocate(newcap);
+    if(new_data == elems){
+      realcap = newcap;
+      return;
+    }
+    try{
+      relocate(elems, cap, new_data);
+    }
+    catch(...){
+      self().deallocate(new_data);
+      throw;
+    }
+    self().deallocate(elems);
+    elems = new_data;
+    realcap = newcap;
+  }
+  /**
+   * A [cap, n) helyeken objektumot hoz létre: value esetén értékinicializálással (nulla), egyébként alapértelmezett inicializálással.
+   * Kivétel esetén a már létrehozottakat megszünteti, a cap nem változik.
+   */
+  void construct_to(size_t n, bool value){
+    size_t i = cap;
+    try{
+      for(; i < n; ++i){
+        if(value) ::new(static_cast<void*>(elems + i)) T();
+        else ::new(static_cast<void*>(elems + i)) T;
+      }
+    }
+    catch(...){
+      destroy(elems + cap, elems + i);
+      throw;
+    }
+  }
+  /**
+   * Az üres tárolóba (a memória már legalább n elemnyi) átmásolja a src tömb n elemét.
+   * Kivétel esetén a már létrehozottakat megszünteti, a memóriát a hívó szabadítja fel.
+   */
+  void copy_from(const T* src, size_t n){
+    if(trivial){
+      if(n > 0) memcpy(static_cast<void*>(elems), src, n*sizeof(T));
+    }
+    else{
+      size_t i = 0;
+      try{
+        for(; i < n; ++i) ::new(static_cast<void*>(elems + i)) T(src[i]);
+      }
+      catch(...){
+        destroy(elems, elems + i);
+        throw;
+      }
+    }
+    cap = n;
+  }
+  /**
+   * Megszünteti az összes elemet és felszabadítja a memóriát; a tároló ezután üres, memória nélküli.
+   */
+  void release(){
+    destroy(elems, elems + cap);
+    self().deallocate(elems);
+    elems = NULL;
+    cap = 0;
+    realcap = 0;
+  }
 public:
   /**
    * Iterátor osztály a generikus használat jegyében.
+   * Közvetlen hozzáférésű (random access) iterátor, így az <algorithm> függvényei (sort, lower_bound, ...) is használhatók vele.
    */
   class iterator{
     T* cell;
   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T* pointer;
+    typedef T& reference;
     iterator(T* cell = NULL): cell(cell){}
     /**
      * Összehasonlító operátor overload.
-     * Összehasoníltja az iterátor által mutatott elem adatát, egy másik iterátor által mutatott elem adatával.
+     * Összehasoníltja az iterátor által mutatott elem címét, egy másik iterátor által mutatott elem címével.
      * @return bool érték, igaz ha egyenlőek, hamis ha nem.
      * @param other másik iterátor
      */
     bool operator==(const iterator other) const{
      return cell == other.cell; 
     }
+    /**
+     * Összehasonlító-negált operátor overload.
+     * @return bool érték, igaz ha nem egyenlőek, hamis ha igen.
+     * @param other másik iterátor
+     */
+    bool operator!=(const iterator other)const{
+      return cell != other.cell;
+    }
+    /**
+     * Rendező operátorok: az iterátorok a tárolóbeli pozíciójuk szerint rendeződnek.
+     */
+    bool operator<(const iterator other) const{ return cell < other.cell; }
+    bool operator>(const iterator other) const{ return cell > other.cell; }
+    bool operator<=(const iterator other) const{ return cell <= other.cell; }
+    bool operator>=(const iterator other) const{ return cell >= other.cell; }
     /**
      * Preinkremens operátor overload.
      * Az iterátort átállítja a következő cellára preinkremens módon.
      * @return iterator& iterátor refernciával tér vissza, így használható balértékként.
      */
     iterator& operator++(){
-      if(cell != NULL) ++cell;
+      ++cell;
       return *this;
     }
     /**
-     * Kivonás operátor.
-     * Az iterátort átállítja rhs-sel előrébb lévő cellára.
-     * Nem kezel hibát.
-     * @param az eltolás értéke.
+     * Posztinkremens operátor overload.
+     * Az iterátort átállítja a következő cellára posztinkremens módon.
+     * @return iterator az előző állapot.
      */
-    iterator& operator-(int rhs){
+    iterator operator++(int){
+      iterator tmp = *this;
+      ++cell;
+      return tmp;
+    }
+    /**
+     * Predekremens operátor, az előző cellára lép.
+     */
+    iterator& operator--(){
+      --cell;
+      return *this;
+    }
+    /**
+     * Posztdekremens operátor, az előző cellára lép.
+     */
+    iterator operator--(int){
+      iterator tmp = *this;
+      --cell;
+      return tmp;
+    }
+    /**
+     * Léptetés helyben rhs cellával később (negatív rhs esetén korábbra). Nem kezel hibát.
+     */
+    iterator& operator+=(difference_type rhs){
+      cell += rhs;
+      return *this;
+    }
+    /**
+     * Léptetés helyben rhs cellával korábbra. Nem kezel hibát.
+     */
+    iterator& operator-=(difference_type rhs){
       cell -= rhs;
       return *this;
     }
     /**
      * Hozzáadás operátor.
-     * Az iterátort átállítja rhs-sel később lévő cellára.
+     * Visszaad egy rhs-sel később lévő cellára mutató iterátort, az eredeti nem változik.
      * Nem kezel hibát.
-     * @param az eltolás értéke.
+     * @param rhs az eltolás értéke.
      */
-    iterator& operator+(int rhs){
-      cell += rhs;
-      return *this;
+    iterator operator+(difference_type rhs) const{
+      return iterator(cell + rhs);
+    }
+    friend iterator operator+(difference_type lhs, const iterator rhs){
+      return iterator(rhs.cell + lhs);
     }
     /**
-     * Posztinkremens operátor overload.
-     * Az iterátort átállítja a következő cellára posztinkremens módon.
-     * @return iterator& iterátor refernciával tér vissza, így használható balértékként.
+     * Kivonás operátor.
+     * Visszaad egy rhs-sel előrébb lévő cellára mutató iterátort, az eredeti nem változik.
+     * Nem kezel hibát.
+     * @param rhs az eltolás értéke.
      */
-    iterator operator++(int){
-      iterator tmp = *this;
-      ++(*this);
-      return tmp;
+    iterator operator-(difference_type rhs) const{
+      return iterator(cell - rhs);
     }
     /**
-     * Összehasonlító-negált operátor overload.
-     * Összehasoníltja az iterátor által mutatott elem adatát, egy másik iterátor által mutatott elem adatával.
-     * @return bool érték, igaz ha nem egyenlőek, hamis ha igen.
-     * @param other másik iterátor
+     * Két iterátor távolsága.
+     * @param rhs a másik iterátor, ugyanabból a tárolóból.
+     * @return difference_type.
      */
-    bool operator!=(const iterator other)const{
-      return cell != other.cell;
+    difference_type operator-(const iterator rhs) const{
+      return cell - rhs.cell;
     }
     /**
      * Dereferáló operátor overload.
@@ -95,33 +277,70 @@ public:
     T* operator->() const{
       return cell;
     }
+    /**
+     * Indexelés az iterátorhoz képest, ellenőrzés nélkül.
+     */
+    T& operator[](difference_type idx) const{
+      return cell[idx];
+    }
   };
+  /**
+   * Konstans iterátor, ugyanazokkal a műveletekkel, mint az iterator, de csak olvasható elemekkel.
+   * Az iterator automatikusan konvertálódik rá.
+   */
   class const_iterator{
     T const * cell;
   public:
-    const_iterator(T* cell = NULL): cell(cell){}
-    bool operator==(const iterator other) const{
-     return cell == other.cell; 
-    }
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+    const_iterator(const T* cell = NULL): cell(cell){}
+    const_iterator(const iterator other): cell(other.operator->()){}
+    bool operator==(const const_iterator other) const{ return cell == other.cell; }
+    bool operator!=(const const_iterator other) const{ return cell != other.cell; }
+    bool operator<(const const_iterator other) const{ return cell < other.cell; }
+    bool operator>(const const_iterator other) const{ return cell > other.cell; }
+    bool operator<=(const const_iterator other) const{ return cell <= other.cell; }
+    bool operator>=(const const_iterator other) const{ return cell >= other.cell; }
     const_iterator& operator++(){
-      if(cell != NULL) ++cell;
+      ++cell;
       return *this;
     }
     const_iterator operator++(int){
-      iterator tmp = *this;
-      ++(*this);
+      const_iterator tmp = *this;
+      ++cell;
       return tmp;
     }
-    const_iterator& operator-(int rhs){
-      cell -= rhs;
+    const_iterator& operator--(){
+      --cell;
       return *this;
     }
-    const_iterator& operator+(int rhs){
+    const_iterator operator--(int){
+      const_iterator tmp = *this;
+      --cell;
+      return tmp;
+    }
+    const_iterator& operator+=(difference_type rhs){
       cell += rhs;
       return *this;
     }
-    bool operator!=(const const_iterator other)const{
-      return cell != other.cell;
+    const_iterator& operator-=(difference_type rhs){
+      cell -= rhs;
+      return *this;
+    }
+    const_iterator operator+(difference_type rhs) const{
+      return const_iterator(cell + rhs);
+    }
+    friend const_iterator operator+(difference_type lhs, const const_iterator rhs){
+      return const_iterator(rhs.cell + lhs);
+    }
+    const_iterator operator-(difference_type rhs) const{
+      return const_iterator(cell - rhs);
+    }
+    difference_type operator-(const const_iterator rhs) const{
+      return cell - rhs.cell;
     }
     const T& operator*() const{
       return *cell;
@@ -129,65 +348,64 @@ public:
     const T* operator->() const{
       return cell;
     }
+    const T& operator[](difference_type idx) const{
+      return cell[idx];
+    }
   };
   /**
    * Visszadja a tároló első elemére mutató iterátort.
    * @return iterator
    */
   iterator begin() {
-    return iterator(data);
+    return iterator(elems);
   }
   /**
    * Visszadja a tároló utolsó eleme utánra mutató iterátort.
    * @return iterator
    */
   iterator end() {
-    return iterator(data+cap);
+    return iterator(elems+cap);
   }
   const_iterator begin() const{
-    return const_iterator(data);
+    return const_iterator(elems);
   }
   const_iterator end() const {
-    return const_iterator(data+cap);
+    return const_iterator(elems+cap);
   }
   /**
-   * Konstruktor.
-   * Lefoglal size méretű T típusú tömböt dinamikusan.
-   * @param size a tömb mérete.
+   * Visszaadja az első elem címét; az elemek folytonosan, egymás után helyezkednek el.
+   * Üres tárolónál NULL is lehet. A pointer a következő nyújtásig (push_back, reserve, ...) érvényes.
+   * @return T*.
    */
-  Vector(size_t size = 0): cap(size), realcap(size){
-    data = new T[cap];
+  T* data(){
+    return elems;
   }
   /**
-   * Másoló konstruktor.
-   * Inicializálja a tárolót a paraméterként kapott másik Vector tároló adataival és méretével.
-   * @param other a másik Vector típusú tároló.
+   * Konstans változat.
+   * @return const T*.
    */
-  Vector(const Vector& other){
-    cap = other.cap;
-    realcap = other.realcap;
-    data = new T[realcap];
-    for (size_t i = 0; i < cap; i++) {
-      data[i] = other.data[i]; 
-    }
+  const T* data() const{
+    return elems;
   }
   /**
-   * Értékadó operátor.
-   * Felszabadítja a tároló által foglalt memóriát, majd inicializálja a tárolót a paraméterként kapott másik Vector tároló adataival és méretével.
-   * @param other a másik Vector típusó tároló.
-   * @return Vector& referencia tehát használható balértékként.
+   * Nézet a teljes tartalomra, a forró ciklusok ellenőrzés nélküli eléréséhez.
+   * @return Span<T>.
    */
-  Vector& operator=(const Vector& other){
-    if(&other != this){
-      delete[] data;
-      cap = other.cap;
-      realcap = other.realcap;
-      data = new T[realcap];
-      for (size_t i = 0; i < cap; i++) {
-        data[i] = other.data[i]; 
-      }
-    }
-    return *this;
+  Span<T> span(){
+    return Span<T>(elems, cap);
+  }
+  /**
+   * Csak olvasható nézet a teljes tartalomra.
+   * @return Span<const T>.
+   */
+  Span<const T> span() const{
+    return Span<const T>(elems, cap);
+  }
+  /**
+   * Konverzió csak olvasható nézetté, hogy a tároló közvetlenül átadható legyen Span<const T> paraméternek.
+   */
+  operator Span<const T>() const{
+    return span();
   }
   /**
    * Méret lekérdezése.
@@ -206,52 +424,136 @@ public:
     return realcap;
   }
   /**
-   * Indexelő operátor.
-   * Visszadja a tároló adott indexű elemét, ha az index a tároló tartományába esik.
-   * Máskülönben hibát kezel és exceptiont dob.
+   * Indexelő operátor, ellenőrzés nélkül.
+   * Visszadja a tároló adott indexű elemét; az indexnek a tároló tartományába kell esnie.
+   * A forró ciklusokban így nincs elágazás, és a fordító vektorizálhatja őket. Ellenőrzött eléréshez lásd az at()-et.
    * @param idx az adott index.
    * @return T& referencia tehát használható balértékként.
    */
   T& operator[](size_t idx){
-    if(idx < 0 || idx >= cap) throw std::out_of_range("Az index a vector határain kívül esik!");
-    else{
-      return data[idx];
-    }
+    return elems[idx];
+  }
+  /**
+   * Konstans indexelő operátor, ellenőrzés nélkül.
+   * @param idx az adott index.
+   * @return const T&.
+   */
+  const T& operator[](size_t idx) const{
+    return elems[idx];
   }
   /**
-   * Konstans indexelő operátor.
+   * Ellenőrzött indexelés.
    * Visszadja a tároló adott indexű elemét, ha az index a tároló tartományába esik.
    * Máskülönben hibát kezel és exceptiont dob.
    * @param idx az adott index.
+   * @return T& referencia tehát használható balértékként.
+   */
+  T& at(size_t idx){
+    if(idx >= cap) throw std::out_of_range("Az index a vector határain kívül esik!");
+    return elems[idx];
+  }
+  /**
+   * Konstans ellenőrzött indexelés.
+   * @param idx az adott index.
    * @return const T&.
    */
-  const T& operator[](size_t idx) const{
-    if(idx < 0 || idx >= cap) throw std::out_of_range("Az index a vector határain kívül esik!");
-    else{
-      return data[idx];
-    }
+  const T& at(size_t idx) const{
+    if(idx >= cap) throw std::out_of_range("Az index a vector határain kívül esik!");
+    return elems[idx];
+  }
+  /**
+   * Lefoglal legalább n elemnyi helyet, hogy a következő hozzáadások ne nyújtsanak.
+   * Ha a valódi kapacitás már legalább n, nem csinál semmit.
+   * @param n a kívánt valódi kapacitás.
+   */
+  void reserve(size_t n){
+    if(n > realcap) reallocate(n);
+  }
+  /**
+   * A valódi kapacitást a méretre csökkenti, a fölösleges memóriát felszabadítja.
+   */
+  void shrink_to_fit(){
+    if(realcap > cap) reallocate(cap);
   }
   /**
    * Dinamikus nyújtásos hozzáadás.
-   * A tároló méretét megnyújta (ha szükséges), majd a végére rakja az adott új elemet.
-   * Megnyújtás alatt azt értjük, hogy egy új nagyobb tömböt foglalunk majd oda másoljuk a régi adatot.
-   * Itt használódik ki a realcap előnye, mivel minden nyújtásnál 10-zel előre megnyújtja a tároló méretét. így nem minden hozzáadásnál kell egyesével nyújtani, tehát a foglalás burstben történik.
+   * A tároló végére rakja az adott új elem másolatát, a nyújtást lásd az emplace_back-nél.
+   * @param _data az új elem.
    */
   void push_back(const T& _data){
+    emplace_back(_data);
+  }
+  /**
+   * Dinamikus nyújtásos hozzáadás mozgatással.
+   * @param _data az új elem, ennek tartalmát átveszi.
+   */
+  void push_back(T&& _data){
+    emplace_back(std::move(_data));
+  }
+  /**
+   * Dinamikus nyújtásos hozzáadás, az új elemet a paraméterekből hozza létre.
+   * Megnyújtás alatt azt értjük, hogy egy új nagyobb tömböt foglalunk majd oda mozgatjuk a régi adatot.
+   * Itt használódik ki a realcap előnye: minden nyújtásnál megduplázza a valódi kapacitást (legalább 10-re),
+   * így N elem hozzáadása O(log N) foglalással és összesen O(N) mozgatással jár.
+   * Az új elem a régiek áthelyezése előtt jön létre, így a tároló saját eleme is hozzáadható.
+   * @param args az új elem konstruktorának paraméterei.
+   * @return T& az új elem.
+   */
+  template<typename... Args>
+  T& emplace_back(Args&&... args){
     if(cap == realcap){
-      realcap += 10;
-      T* new_data = new T[realcap];
-      for (size_t i = 0; i < cap; i++) {
-      new_data[i] = data[i]; 
+      size_t newcap = realcap < 5 ? 10 : 2*realcap;
+      T* new_data = self().allocate(newcap);
+      try{
+        ::new(static_cast<void*>(new_data + cap)) T(std::forward<Args>(args)...);
+      }
+      catch(...){
+        self().deallocate(new_data);
+        throw;
       }
-      new_data[cap] = _data;
-      delete[] data;
-      data = new_data;
+      try{
+        relocate(elems, cap, new_data);
+      }
+      catch(...){
+        new_data[cap].~T();
+        self().deallocate(new_data);
+        throw;
+      }
+      self().deallocate(elems);
+      elems = new_data;
+      realcap = newcap;
     }
     else {
-      data[cap] = _data;
+      ::new(static_cast<void*>(elems + cap)) T(std::forward<Args>(args)...);
+    }
+    return elems[cap++];
+  }
+  /**
+   * Átméretezés.
+   * Csökkentéskor a fölösleges elemeket megszünteti, növeléskor az új elemeket értékinicializálja (beépített típusoknál nulla).
+   * Nyújtáskor legalább duplázza a valódi kapacitást, így az ismételt kis növelés sem jár minden hívásnál foglalással.
+   * @param n az új méret.
+   */
+  void resize(size_t n){
+    if(n <= cap){
+      destroy(elems + n, elems + cap);
+    }
+    else{
+      if(n > realcap) reallocate(n > 2*realcap ? n : 2*realcap);
+      construct_to(n, true);
     }
-    cap++;
+    cap = n;
+  }
+  /**
+   * Átméretezés inicializálás nélkül, csak triviális típusokra.
+   * Az új elemek értéke meghatározatlan, a hívónak mindet felül kell írnia, mielőtt olvasná.
+   * Így a nagy kimeneti bufferek (pl. a titkosítók eredménye) létrehozása nem jár egy fölösleges memória menettel.
+   * @param n az új méret.
+   */
+  void resize_uninitialized(size_t n){
+    static_assert(trivial, "resize_uninitialized csak trivialis tipusokra hasznalhato");
+    if(n > realcap) reallocate(n > 2*realcap ? n : 2*realcap);
+    cap = n;
   }
   /**
    * Kiírja az elemeket, az adott streamre.
@@ -266,10 +568,12 @@ public:
   }
   /**
    * Tartalom szerint összehasonlító operátor.
-   * @param other egy másik Vector<T> tároló.
+   * Eltérő igazítású vagy fajtájú tárolóval (Vector, SmallVector) is összehasonlítható.
+   * @param other egy másik, T típusú elemeket tároló tároló.
    * @return bool.
    */
-  bool operator==(const Vector<T>& other){
+  template<typename D2>
+  bool operator==(const VectorBase<T, D2>& other) const{
     if(other.size() == cap){
       for(size_t i = 0; i < cap; ++i){
         if(other[i] != (*this)[i]) return false;
@@ -278,12 +582,160 @@ public:
     }
     return false;
   }
+};
+
+/**
+ * Generikus tároló osztály.
+ * Az std::vector szabványát követi, ezzel megvalósítva egy generikus nyújtató tömb osztályt.
+ * A memóriát nyersen (konstruálatlanul) foglalja, és csak az első cap helyen él objektum, így a tartalék helyek nem kerülnek konstruálásba.
+ * Az A igazítási szabály (alapértelmezetten alignof(T)) adja meg, milyen határra igazodjon a memória; a valódi igazítás legalább alignof(T).
+ * Az elemek kezelése, a nyújtás és az indexelés a VectorBase-ben van, itt csak a memória foglalása.
+ */
+template<typename T, typename A = Align<alignof(T)>>
+class Vector: public VectorBase<T, Vector<T, A>>{
+  typedef VectorBase<T, Vector<T, A>> Base;
+  friend Base;
+  using Base::elems;
+  using Base::cap;
+  using Base::realcap;
+  using Base::destroy;
+  using Base::construct_to;
+  using Base::copy_from;
+  using Base::release;
+public:
+  static constexpr size_t alignment = A::value > alignof(T) ? A::value : alignof(T); /**< a tároló memóriájának igazítása byte-ban.*/
+private:
+  /**
+   * Nyers, konstruálatlan memóriát foglal n elemnek (n == 0 esetén NULL), alignment byte-os határra igazítva.
+   * Ha az igazítás nagyobb annál, amit a sima operator new garantál, az igazított változatát hívja.
+   */
+  static T* allocate(size_t& n){
+    if(n == 0) return NULL;
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) return static_cast<T*>(::operator new(n*sizeof(T), std::align_val_t(alignment)));
+    return static_cast<T*>(::operator new(n*sizeof(T)));
+  }
+  /**
+   * Felszabadítja az allocate által foglalt memóriát; az elemeket előbb meg kell szüntetni.
+   */
+  static void deallocate(T* p){
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) ::operator delete(p, std::align_val_t(alignment));
+    else ::operator delete(p);
+  }
+public:
+  /**
+   * Konstruktor.
+   * Lefoglal size méretű T típusú tömböt dinamikusan, az elemeket alapértelmezett inicializálással hozza létre
+   * (mint a new T[size]: osztályoknál a paraméter nélküli konstruktor, beépített típusoknál nincs inicializálás).
+   * @param size a tömb mérete.
+   */
+  Vector(size_t size = 0){
+    realcap = size;
+    elems = allocate(realcap);
+    try{
+      construct_to(size, false);
+    }
+    catch(...){
+      deallocate(elems);
+      throw;
+    }
+    cap = size;
+  }
+  /**
+   * Létrehoz egy size méretű tárolót, amelynek elemeit nem inicializálja, mert a hívó úgyis felülírja mindet.
+   * Csak triviális típusokra (pl. uint8_t, Digest), lásd resize_uninitialized.
+   * @param size a tömb mérete.
+   * @return Vector.
+   */
+  static Vector for_overwrite(size_t size){
+    Vector res;
+    res.resize_uninitialized(size);
+    return res;
+  }
+  /**
+   * Másoló konstruktor.
+   * Inicializálja a tárolót a paraméterként kapott másik Vector tároló adataival és méretével.
+   * @param other a másik Vector típusú tároló.
+   */
+  Vector(const Vector& other){
+    realcap = other.cap;
+    elems = allocate(realcap);
+    try{
+      copy_from(other.elems, other.cap);
+    }
+    catch(...){
+      deallocate(elems);
+      throw;
+    }
+  }
+  /**
+   * Konvertáló konstruktor eltérő igazítású Vector-ról.
+   * Explicit, mert minden elemet új memóriába másol, és az igazítást sem viszi át,
+   * így pl. egy Ciphertext Vector<uint8_t>-be másolása a hívás helyén látszik.
+   * @param other a másik, T típusú elemeket tároló Vector.
+   */
+  template<typename B>
+  explicit Vector(const Vector<T, B>& other){
+    realcap = other.size();
+    elems = allocate(realcap);
+    try{
+      copy_from(other.data(), other.size());
+    }
+    catch(...){
+      deallocate(elems);
+      throw;
+    }
+  }
+  /**
+   * Mozgató konstruktor.
+   * Átveszi a másik tároló memóriáját másolás nélkül, a másik tároló üres marad.
+   * Így a függvényből visszaadott (pl. Cipher::encode) tárolók átadása nem másolja az elemeket.
+   * @param other a másik Vector típusú tároló.
+   */
+  Vector(Vector&& other) noexcept{
+    elems = other.elems;
+    cap = other.cap;
+    realcap = other.realcap;
+    other.elems = NULL;
+    other.cap = 0;
+    other.realcap = 0;
+  }
+  /**
+   * Értékadó operátor.
+   * Felszabadítja a tároló által foglalt memóriát, majd inicializálja a tárolót a paraméterként kapott másik Vector tároló adataival és méretével.
+   * @param other a másik Vector típusó tároló.
+   * @return Vector& referencia tehát használható balértékként.
+   */
+  Vector& operator=(const Vector& other){
+    if(&other != this){
+      *this = Vector(other);
+    }
+    return *this;
+  }
+  /**
+   * Mozgató értékadó operátor.
+   * Felszabadítja a tároló által foglalt memóriát, majd átveszi a másik tárolóét, a másik tároló üres marad.
+   * @param other a másik Vector típusú tároló.
+   * @return Vector& referencia tehát használható balértékként.
+   */
+  Vector& operator=(Vector&& other) noexcept{
+    if(&other != this){
+      release();
+      elems = other.elems;
+      cap = other.cap;
+      realcap = other.realcap;
+      other.elems = NULL;
+      other.cap = 0;
+      other.realcap = 0;
+    }
+    return *this;
+  }
   /**
    * Destruktor.
    * A dinamikusan foglalt memória területet felszabadítja.
    */
   ~Vector(){
-    delete[] data;
+    destroy(elems, elems + cap);
+    deallocate(elems);
   }
 };
 #endif // !VECTOR